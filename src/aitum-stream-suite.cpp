@@ -15,7 +15,13 @@
 #include "docks/transitions-dock.hpp"
 #include "utils/file-download.h"
 #include "utils/icon.hpp"
-#include "utils/obs-websocket-api.h"
+#include "utils/preview-texture.hpp"
+#include "utils/properties-cache.hpp"
+#include "utils/registry.hpp"
+#include "utils/scene-links.hpp"
+#include "utils/scene-preload.hpp"
+#include "utils/switch-latency.hpp"
+#include "utils/vendor-events.hpp"
 #include "utils/widgets/pixmap-label.hpp"
 #include "version.h"
 #include <obs-frontend-api.h>
@@ -67,7 +73,6 @@ QList<QString> loaded_docks;
 
 extern std::list<CanvasDock *> canvas_docks;
 extern std::list<CanvasCloneDock *> canvas_clone_docks;
-extern obs_websocket_vendor vendor;
 
 std::list<QFrame *> empty_docks;
 std::vector<std::tuple<std::string, std::string, std::string>> extensions = {};
@@ -1072,6 +1077,7 @@ void load_canvas(bool check_new_canvas)
 				title += name;
 				if (obs_frontend_add_dock_by_id(name, title.c_str(), ccd)) {
 					canvas_clone_docks.push_back(ccd);
+					registry_add_canvas_clone_dock(ccd);
 					if (!obs_data_get_bool(t, "has_loaded")) {
 						ccd->parentWidget()->show();
 						obs_data_set_bool(t, "has_loaded", true);
@@ -1127,6 +1133,7 @@ void load_canvas(bool check_new_canvas)
 				title += name;
 				if (obs_frontend_add_dock_by_id(name, title.c_str(), cd)) {
 					canvas_docks.push_back(cd);
+					registry_add_canvas_dock(cd);
 					if (!obs_data_get_bool(t, "has_loaded")) {
 						cd->parentWidget()->show();
 						obs_data_set_bool(t, "has_loaded", true);
@@ -1678,7 +1685,10 @@ static void frontend_event(enum obs_frontend_event event, void *private_data)
 		for (const auto &it : canvas_docks) {
 			QMetaObject::invokeMethod(it, "MainSceneChanged", Qt::QueuedConnection);
 		}
+	} else if (event == OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED) {
+		scene_links_invalidate();
 	} else if (event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED) {
+		scene_links_invalidate();
 		if (finished_loading) {
 			log_same_sources();
 			struct obs_frontend_source_list transitions = {};
@@ -1772,6 +1782,65 @@ bool obs_data_array_equal(obs_data_array_t *a, obs_data_array_t *b)
 	return true;
 }
 
+static bool obs_data_array_has_name(obs_data_array_t *array, const char *name, const char *json)
+{
+	bool found = false;
+	size_t count = obs_data_array_count(array);
+	for (size_t i = 0; i < count && !found; i++) {
+		obs_data_t *item = obs_data_array_item(array, i);
+		found = strcmp(obs_data_get_string(item, "name"), name) == 0 &&
+			(!json || strcmp(obs_data_get_json(item), json) == 0);
+		obs_data_release(item);
+	}
+	return found;
+}
+
+// lists the names that were added, removed or changed between two config arrays
+static obs_data_t *obs_data_array_delta(obs_data_array_t *a, obs_data_array_t *b)
+{
+	auto delta = obs_data_create();
+	auto added = obs_data_array_create();
+	auto removed = obs_data_array_create();
+	auto changed = obs_data_array_create();
+	size_t count = obs_data_array_count(b);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(b, i);
+		const char *name = obs_data_get_string(item, "name");
+		obs_data_array_t *target = nullptr;
+		if (!obs_data_array_has_name(a, name, nullptr)) {
+			target = added;
+		} else if (!obs_data_array_has_name(a, name, obs_data_get_json(item))) {
+			target = changed;
+		}
+		if (target) {
+			auto n = obs_data_create();
+			obs_data_set_string(n, "name", name);
+			obs_data_array_push_back(target, n);
+			obs_data_release(n);
+		}
+		obs_data_release(item);
+	}
+	count = obs_data_array_count(a);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(a, i);
+		const char *name = obs_data_get_string(item, "name");
+		if (!obs_data_array_has_name(b, name, nullptr)) {
+			auto n = obs_data_create();
+			obs_data_set_string(n, "name", name);
+			obs_data_array_push_back(removed, n);
+			obs_data_release(n);
+		}
+		obs_data_release(item);
+	}
+	obs_data_set_array(delta, "added", added);
+	obs_data_set_array(delta, "removed", removed);
+	obs_data_set_array(delta, "changed", changed);
+	obs_data_array_release(added);
+	obs_data_array_release(removed);
+	obs_data_array_release(changed);
+	return delta;
+}
+
 void open_config_dialog(int tab, const char *create_type)
 {
 	if (!configDialog) {
@@ -1801,32 +1870,51 @@ void open_config_dialog(int tab, const char *create_type)
 	if (configDialog->exec() == QDialog::Accepted) {
 		bool canvas_changed = false;
 		bool outputs_changed = false;
+		bool main_outputs_changed = false;
 		bool check_new_canvas = false;
+		bool preload_changed = false;
+		obs_data_t *canvas_delta = nullptr;
+		obs_data_t *outputs_delta = nullptr;
+		const bool reset = !current_profile_config;
 		if (current_profile_config) {
 			auto show = obs_data_get_bool(settings, "main_stream_output_show");
 			if (show != obs_data_get_bool(current_profile_config, "main_stream_output_show")) {
 				obs_data_set_bool(current_profile_config, "main_stream_output_show", show);
 				outputs_changed = true;
+				main_outputs_changed = true;
 			}
 			show = obs_data_get_bool(settings, "main_record_output_show");
 			if (show != obs_data_get_bool(current_profile_config, "main_record_output_show")) {
 				obs_data_set_bool(current_profile_config, "main_record_output_show", show);
 				outputs_changed = true;
+				main_outputs_changed = true;
 			}
 			show = obs_data_get_bool(settings, "main_backtrack_output_show");
 			if (show != obs_data_get_bool(current_profile_config, "main_backtrack_output_show")) {
 				obs_data_set_bool(current_profile_config, "main_backtrack_output_show", show);
 				outputs_changed = true;
+				main_outputs_changed = true;
 			}
 			show = obs_data_get_bool(settings, "main_virtual_cam_output_show");
 			if (show != obs_data_get_bool(current_profile_config, "main_virtual_cam_output_show")) {
 				obs_data_set_bool(current_profile_config, "main_virtual_cam_output_show", show);
 				outputs_changed = true;
+				main_outputs_changed = true;
+			}
+			if (obs_data_has_user_value(settings, "browser_panel_suspend_min")) {
+				obs_data_set_int(current_profile_config, "browser_panel_suspend_min",
+						 obs_data_get_int(settings, "browser_panel_suspend_min"));
+			}
+			const auto preload = obs_data_get_int(settings, "preload_scenes_max");
+			if (obs_data_has_user_value(settings, "preload_scenes_max") && preload != ScenePreloader::MaxScenes()) {
+				obs_data_set_int(current_profile_config, "preload_scenes_max", preload);
+				preload_changed = true;
 			}
 			obs_data_array_t *a = obs_data_get_array(current_profile_config, "canvas");
 			obs_data_array_t *b = obs_data_get_array(settings, "canvas");
 			if (!obs_data_array_equal(a, b)) {
 				canvas_changed = true;
+				canvas_delta = obs_data_array_delta(a, b);
 				obs_data_set_array(current_profile_config, "canvas", b);
 			}
 			obs_data_array_release(a);
@@ -1835,6 +1923,7 @@ void open_config_dialog(int tab, const char *create_type)
 			b = obs_data_get_array(settings, "outputs");
 			if (!obs_data_array_equal(a, b)) {
 				outputs_changed = true;
+				outputs_delta = obs_data_array_delta(a, b);
 				check_new_canvas = true;
 				obs_data_set_array(current_profile_config, "outputs", b);
 			}
@@ -1852,15 +1941,33 @@ void open_config_dialog(int tab, const char *create_type)
 		save_current_profile_config(true);
 		if (canvas_changed) {
 			load_canvas(check_new_canvas);
-			if (vendor) {
-				obs_websocket_vendor_emit_event(vendor, "canvas_changed", nullptr);
+			if (vendor_event_wanted(VENDOR_EVENT_CANVAS)) {
+				if (!canvas_delta)
+					canvas_delta = obs_data_create();
+				obs_data_set_bool(canvas_delta, "reset", reset);
+				vendor_emit_event(VENDOR_EVENT_CANVAS, "canvas_changed", canvas_delta);
 			}
 		}
+		obs_data_release(canvas_delta);
 
 		if (outputs_changed) {
 			load_outputs();
-			if (vendor) {
-				obs_websocket_vendor_emit_event(vendor, "outputs_changed", nullptr);
+			if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
+				if (!outputs_delta)
+					outputs_delta = obs_data_create();
+				obs_data_set_bool(outputs_delta, "reset", reset);
+				obs_data_set_bool(outputs_delta, "main_outputs_changed", main_outputs_changed);
+				vendor_emit_event(VENDOR_EVENT_OUTPUTS, "outputs_changed", outputs_delta);
+			}
+		}
+		obs_data_release(outputs_delta);
+
+		if (preload_changed) {
+			for (const auto &it : canvas_docks) {
+				it->UpdatePreload();
+			}
+			if (live_scenes_dock) {
+				live_scenes_dock->UpdatePreload();
 			}
 		}
 	} else {
@@ -1958,21 +2065,21 @@ bool obs_module_load(void)
 		if (!d.isNull() && d.isValid() && !d.toString().isEmpty()) {
 			modesTab = d.toString();
 			load_dock_state(d.toString());
-			if (vendor) {
+			if (vendor_event_wanted(VENDOR_EVENT_DOCKS)) {
 				auto d2 = obs_data_create();
 				obs_data_set_string(d2, "name", d.toString().toUtf8().constData());
 				obs_data_set_bool(d2, "fixed", true);
-				obs_websocket_vendor_emit_event(vendor, "switched_dock_mode", d2);
+				vendor_emit_event(VENDOR_EVENT_DOCKS, "switched_dock_mode", d2);
 				obs_data_release(d2);
 			}
 		} else {
 			modesTab = modesTabBar->tabText(index);
 			load_dock_state(modesTabBar->tabText(index));
-			if (vendor) {
+			if (vendor_event_wanted(VENDOR_EVENT_DOCKS)) {
 				auto d2 = obs_data_create();
 				obs_data_set_string(d2, "name", modesTabBar->tabText(index).toUtf8().constData());
 				obs_data_set_bool(d2, "fixed", false);
-				obs_websocket_vendor_emit_event(vendor, "switched_dock_mode", d2);
+				vendor_emit_event(VENDOR_EVENT_DOCKS, "switched_dock_mode", d2);
 				obs_data_release(d2);
 			}
 		}
@@ -2216,8 +2323,17 @@ bool obs_module_load(void)
 		url += pguid;
 	}
 
-	version_download_info =
-		download_info_create_single("[Aitum Stream Suite]", "OBS", url.c_str(), version_info_downloaded, nullptr);
+	auto cache_file = obs_module_config_path("cache/streamsuite.json");
+	struct download_options options = {};
+	options.log_prefix = "[Aitum Stream Suite] ";
+	options.user_agent = "OBS";
+	options.url = url.c_str();
+	options.priority = DOWNLOAD_PRIORITY_HIGH;
+	options.cache_file = cache_file;
+	// the metadata is parsed as one document, so keep what it can grow to bounded
+	options.max_size = 4 * 1024 * 1024;
+	version_download_info = download_info_create(&options, version_info_downloaded, nullptr);
+	bfree(cache_file);
 	return true;
 }
 
@@ -2343,6 +2459,7 @@ void obs_module_unload()
 		download_info_destroy(version_download_info);
 		version_download_info = nullptr;
 	}
+	download_manager_shutdown();
 	if (current_profile_config) {
 		obs_data_release(current_profile_config);
 		current_profile_config = nullptr;
@@ -2379,6 +2496,9 @@ void obs_module_unload()
 		delete cef;
 		cef = nullptr;
 	}
+	preview_texture_free_all();
+	switch_latency_free_all();
+	properties_cache_free();
 }
 
 MODULE_EXPORT const char *obs_module_description(void)
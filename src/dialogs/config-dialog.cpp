@@ -30,8 +30,10 @@
 #include <QTextEdit>
 #include <QUrl>
 #include <QSignalBlocker>
+#include <src/docks/browser-dock.hpp>
 #include <src/docks/canvas-dock.hpp>
 #include <src/utils/color.hpp>
+#include <src/utils/scene-preload.hpp>
 #include <src/utils/widgets/focus-scroll-spinbox.hpp>
 #include <sstream>
 #include <util/config-file.h>
@@ -176,7 +178,31 @@ OBSBasicSettings::OBSBasicSettings(QMainWindow *parent) : QDialog(parent)
 
 	buttonGroupBox->setLayout(buttonLayout);
 
+	auto browserBox = new QGroupBox(QString::fromUtf8(obs_module_text("BrowserPanels")));
+	auto browserLayout = new QFormLayout;
+	browserBox->setLayout(browserLayout);
+	browserSuspend = new QSpinBox;
+	browserSuspend->setRange(0, 1440);
+	browserSuspend->setSuffix(" min");
+	browserSuspend->setSpecialValueText(QString::fromUtf8(obs_module_text("Never")));
+	connect(browserSuspend, &QSpinBox::valueChanged,
+		[this] { obs_data_set_int(main_settings, "browser_panel_suspend_min", browserSuspend->value()); });
+	browserLayout->addRow(QString::fromUtf8(obs_module_text("BrowserPanelSuspend")), browserSuspend);
+
+	auto preloadBox = new QGroupBox(QString::fromUtf8(obs_module_text("ScenePreload")));
+	auto preloadLayout = new QFormLayout;
+	preloadBox->setLayout(preloadLayout);
+	preloadScenes = new QSpinBox;
+	preloadScenes->setRange(0, 8);
+	preloadScenes->setSpecialValueText(QString::fromUtf8(obs_module_text("Never")));
+	preloadScenes->setToolTip(QString::fromUtf8(obs_module_text("ScenePreloadTooltip")));
+	connect(preloadScenes, &QSpinBox::valueChanged,
+		[this] { obs_data_set_int(main_settings, "preload_scenes_max", preloadScenes->value()); });
+	preloadLayout->addRow(QString::fromUtf8(obs_module_text("ScenePreloadMax")), preloadScenes);
+
 	generalPageLayout->addWidget(infoBox, 0);
+	generalPageLayout->addWidget(browserBox, 0);
+	generalPageLayout->addWidget(preloadBox, 0);
 	generalPageLayout->addWidget(buttonGroupBox, 1);
 
 	QScrollArea *scrollArea = new QScrollArea;
@@ -970,6 +996,18 @@ void OBSBasicSettings::LoadSettings(obs_data_t *settings)
 	mainRecord->setChecked(obs_data_get_bool(settings, "main_record_output_show"));
 	mainBacktrack->setChecked(obs_data_get_bool(settings, "main_backtrack_output_show"));
 	mainVirtualCam->setChecked(obs_data_get_bool(settings, "main_virtual_cam_output_show"));
+	{
+		QSignalBlocker blocker(browserSuspend);
+		browserSuspend->setValue(obs_data_has_user_value(settings, "browser_panel_suspend_min")
+						 ? (int)obs_data_get_int(settings, "browser_panel_suspend_min")
+						 : BROWSER_PANEL_SUSPEND_DEFAULT_MIN);
+	}
+	{
+		QSignalBlocker blocker(preloadScenes);
+		preloadScenes->setValue(obs_data_has_user_value(settings, "preload_scenes_max")
+						? (int)obs_data_get_int(settings, "preload_scenes_max")
+						: SCENE_PRELOAD_DEFAULT_MAX);
+	}
 
 	obs_data_array_release(extra_outputs);
 	extra_outputs = obs_data_get_array(settings, "outputs");
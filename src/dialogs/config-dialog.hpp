@@ -85,6 +85,9 @@ private:
 	QCheckBox *mainBacktrack;
 	QCheckBox *mainVirtualCam;
 
+	QSpinBox *browserSuspend;
+	QSpinBox *preloadScenes;
+
 	std::vector<OBSHotkeyWidget *> hotkeys;
 
 	void AddStream();
@@ -1,9 +1,16 @@
 #include "browser-dock.hpp"
+#include <QHideEvent>
+#include <QShowEvent>
 #include <QVBoxLayout>
 #include <obs-frontend-api.h>
+#include <obs-module.h>
+#include <util/platform.h>
 
 QCef *cef = nullptr;
 QCefCookieManager *panel_cookies = nullptr;
+extern obs_data_t *current_profile_config;
+
+static int loaded_browser_docks = 0;
 
 bool load_cef()
 {
@@ -21,7 +28,7 @@ bool load_cef()
 	return cef != nullptr;
 }
 
-BrowserDock::BrowserDock(const char *name, const char *url_, QWidget *parent) : QWidget(parent), url(url_)
+BrowserDock::BrowserDock(const char *name, const char *url_, QWidget *parent) : QWidget(parent), url(url_), currentUrl(url_)
 {
 	setMinimumSize(200, 100);
 	setObjectName(QString::fromUtf8(name));
@@ -40,17 +47,69 @@ BrowserDock::BrowserDock(const char *name, const char *url_, QWidget *parent) :
 	layout = new QVBoxLayout(this);
 	layout->setContentsMargins(0, 0, 0, 0);
 	setLayout(layout);
-	if (cef) {
-		cefWidget = cef->create_widget(this, url, panel_cookies);
-		layout->addWidget(cefWidget);
-	}
+
+	// the renderer is created on first show and released again after being hidden for a while
+	suspendTimer.setSingleShot(true);
+	connect(&suspendTimer, &QTimer::timeout, this, [this] {
+		if (isVisible() || !cefWidget)
+			return;
+		blog(LOG_INFO, "[Aitum Stream Suite] Suspend hidden browser panel '%s'", objectName().toUtf8().constData());
+		DestroyBrowser();
+	});
 }
 
 BrowserDock::~BrowserDock()
 {
+	suspendTimer.stop();
+	DestroyBrowser();
+}
+
+void BrowserDock::CreateBrowser()
+{
+	if (cefWidget || !cef)
+		return;
+	cefWidget = cef->create_widget(this, currentUrl, panel_cookies);
+	if (!cefWidget)
+		return;
+	connect(cefWidget, &QCefWidget::urlChanged, this, [this](const QString &u) { currentUrl = u.toUtf8().constData(); });
+	layout->addWidget(cefWidget);
+	loads++;
+	loadedAt = os_gettime_ns();
+	loaded_browser_docks++;
+}
+
+void BrowserDock::DestroyBrowser()
+{
+	if (!cefWidget)
+		return;
 	layout->removeWidget(cefWidget);
+	cefWidget->closeBrowser();
 	cefWidget->setParent(nullptr);
 	cefWidget->deleteLater();
+	cefWidget = nullptr;
+	loadedNs += os_gettime_ns() - loadedAt;
+	loadedAt = 0;
+	loaded_browser_docks--;
+}
+
+void BrowserDock::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+	suspendTimer.stop();
+	hiddenAt = 0;
+	CreateBrowser();
+}
+
+void BrowserDock::hideEvent(QHideEvent *event)
+{
+	QWidget::hideEvent(event);
+	// minimizing the main window is spontaneous, only panels hidden by dock modes or tabs get suspended
+	if (event->spontaneous() || !cefWidget)
+		return;
+	hiddenAt = os_gettime_ns();
+	auto minutes = SuspendMinutes();
+	if (minutes > 0)
+		suspendTimer.start(minutes * 60000);
 }
 
 void BrowserDock::Refresh()
@@ -61,10 +120,40 @@ void BrowserDock::Refresh()
 
 void BrowserDock::Reset()
 {
+	currentUrl = url;
 	if (cefWidget)
 		cefWidget->setURL(url);
 }
 
+obs_data_t *BrowserDock::GetState() const
+{
+	const uint64_t now = os_gettime_ns();
+	auto d = obs_data_create();
+	obs_data_set_string(d, "name", objectName().toUtf8().constData());
+	obs_data_set_string(d, "url", currentUrl.c_str());
+	obs_data_set_bool(d, "loaded", cefWidget != nullptr);
+	obs_data_set_bool(d, "visible", isVisible());
+	obs_data_set_int(d, "loads", loads);
+	obs_data_set_int(d, "loaded_ms", (long long)((loadedNs + (loadedAt ? now - loadedAt : 0)) / 1000000));
+	if (hiddenAt && cefWidget)
+		obs_data_set_int(d, "hidden_ms", (long long)((now - hiddenAt) / 1000000));
+	if (suspendTimer.isActive())
+		obs_data_set_int(d, "suspend_in_ms", suspendTimer.remainingTime());
+	return d;
+}
+
+int BrowserDock::SuspendMinutes()
+{
+	if (!current_profile_config || !obs_data_has_user_value(current_profile_config, "browser_panel_suspend_min"))
+		return BROWSER_PANEL_SUSPEND_DEFAULT_MIN;
+	return (int)obs_data_get_int(current_profile_config, "browser_panel_suspend_min");
+}
+
+int BrowserDock::LoadedCount()
+{
+	return loaded_browser_docks;
+}
+
 void DestroyPanelCookieManager()
 {
 	if (!panel_cookies)
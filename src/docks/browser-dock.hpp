@@ -1,8 +1,12 @@
 #pragma once
 #include "browser-panel.hpp"
+#include <obs.h>
+#include <QTimer>
 #include <QWidget>
 #include <QVBoxLayout>
 
+#define BROWSER_PANEL_SUSPEND_DEFAULT_MIN 5
+
 class BrowserDock : public QWidget {
 	Q_OBJECT
 
@@ -10,11 +14,29 @@ private:
 	QCefWidget *cefWidget = nullptr;
 	QVBoxLayout *layout = nullptr;
 	std::string url;
+	std::string currentUrl;
+	QTimer suspendTimer;
+	uint32_t loads = 0;
+	uint64_t loadedAt = 0;
+	uint64_t loadedNs = 0;
+	uint64_t hiddenAt = 0;
+
+	void CreateBrowser();
+	void DestroyBrowser();
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+
 public:
 	BrowserDock(const char* name, const char *url, QWidget *parent = nullptr);
 	~BrowserDock();
 
 	void Refresh();
 	void Reset();
-};
+	bool IsLoaded() const { return cefWidget != nullptr; }
+	obs_data_t *GetState() const;
 
+	static int SuspendMinutes();
+	static int LoadedCount();
+};
@@ -1,4 +1,6 @@
+#include "../utils/event-filter.hpp"
 #include "../utils/icon.hpp"
+#include "../utils/registry.hpp"
 #include "canvas-clone-dock.hpp"
 #include "canvas-dock.hpp"
 #include <obs-module.h>
@@ -130,12 +132,41 @@ CanvasCloneDock::CanvasCloneDock(obs_data_t *settings_, QWidget *parent)
 	preview->setSizePolicy(sizePolicy1);
 
 	preview->show();
-	connect(preview, &OBSQTDisplay::DisplayCreated,
-		[this]() { obs_display_add_draw_callback(preview->GetDisplay(), DrawPreview, this); });
+	connect(preview, &OBSQTDisplay::DisplayCreated, [this]() {
+		obs_display_add_draw_callback(preview->GetDisplay(), DrawPreview, this);
+		UpdatePreviewEnabled();
+	});
+
+	auto policy = preview_policy_from_string(obs_data_get_string(settings, "preview_policy"));
+	previewDisabled = policy == PreviewPolicy::Disabled;
+	if (!previewDisabled) {
+		previewThrottle.SetPolicy(policy);
+	}
+	auto hoverFilter = new OBSEventFilter([this](QObject *, QEvent *event) {
+		if (event->type() == QEvent::Enter) {
+			previewThrottle.SetHovered(true);
+		} else if (event->type() == QEvent::Leave) {
+			previewThrottle.SetHovered(false);
+		}
+		return false;
+	});
+	hoverFilter->setParent(preview);
+	preview->installEventFilter(hoverFilter);
 
 	preview->setContextMenuPolicy(Qt::CustomContextMenu);
 	QObject::connect(preview, &OBSQTDisplay::customContextMenuRequested, [this] {
 		QMenu menu(this);
+		auto rateMenu = menu.addMenu(QString::fromUtf8(obs_module_text("PreviewRate")));
+		auto addRate = [this, rateMenu](const char *text, PreviewPolicy policy) {
+			auto action = rateMenu->addAction(QString::fromUtf8(obs_module_text(text)),
+							  [this, policy] { SetPreviewPolicy(policy); });
+			action->setCheckable(true);
+			action->setChecked(GetPreviewPolicy() == policy);
+		};
+		addRate("PreviewRateFull", PreviewPolicy::Full);
+		addRate("PreviewRateReduced", PreviewPolicy::Reduced);
+		addRate("PreviewRateHover", PreviewPolicy::Hover);
+		addRate("PreviewRateDisabled", PreviewPolicy::Disabled);
 		auto projectorMenu = menu.addMenu(QString::fromUtf8(obs_frontend_get_locale_string("Projector.Open.Preview")));
 		AddProjectorMenuMonitors(projectorMenu, this, SLOT(OpenPreviewProjector()));
 		menu.addAction(QString::fromUtf8(obs_frontend_get_locale_string("Projector.Window")),
@@ -313,6 +344,8 @@ CanvasCloneDock::~CanvasCloneDock()
 	signal_handler_disconnect(sh, "source_remove", source_remove, this);
 	signal_handler_disconnect(sh, "source_rename", source_rename, this);
 	canvas_clone_docks.remove(this);
+	registry_remove_canvas_clone_dock(this);
+	obs_display_remove_draw_callback(preview->GetDisplay(), DrawPreview, this);
 	obs_remove_tick_callback(Tick, this);
 	obs_data_release(settings);
 	obs_weak_canvas_release(clone);
@@ -370,7 +403,7 @@ void CanvasCloneDock::DrawPreview(void *data, uint32_t cx, uint32_t cy)
 
 	gs_ortho(0.0f, float(sourceCX), 0.0f, float(sourceCY), -100.0f, 100.0f);
 	gs_set_viewport(x, y, (int)newCX, (int)newCY);
-	obs_canvas_render(window->canvas);
+	window->previewThrottle.Render(window->canvas, nullptr, (uint32_t)newCX, (uint32_t)newCY, sourceCX, sourceCY);
 
 	gs_set_linear_srgb(previous);
 
@@ -1040,6 +1073,8 @@ void CanvasCloneDock::SaveSettings(bool closing, QString mode)
 	obs_data_set_array(settings, "projectors", pa);
 	obs_data_array_release(pa);
 
+	obs_data_set_string(settings, "preview_policy", preview_policy_to_string(GetPreviewPolicy()));
+
 	auto state = canvas_split->saveState();
 	auto b64 = state.toBase64();
 	auto state_chars = b64.constData();
@@ -1209,3 +1244,34 @@ void CanvasCloneDock::OpenPreviewProjector()
 	int monitor = sender()->property("monitor").toInt();
 	OpenProjector(monitor);
 }
+
+void CanvasCloneDock::showEvent(QShowEvent *event)
+{
+	if (!occlusionWatched) {
+		occlusionWatched = true;
+		PreviewThrottle::WatchOcclusion(this, [this](bool occluded) {
+			previewOccluded = occluded;
+			UpdatePreviewEnabled();
+		});
+	}
+	QFrame::showEvent(event);
+}
+
+PreviewPolicy CanvasCloneDock::GetPreviewPolicy() const
+{
+	return previewDisabled ? PreviewPolicy::Disabled : previewThrottle.GetPolicy();
+}
+
+void CanvasCloneDock::SetPreviewPolicy(PreviewPolicy policy)
+{
+	previewDisabled = policy == PreviewPolicy::Disabled;
+	if (!previewDisabled) {
+		previewThrottle.SetPolicy(policy);
+	}
+	UpdatePreviewEnabled();
+}
+
+void CanvasCloneDock::UpdatePreviewEnabled()
+{
+	obs_display_set_enabled(preview->GetDisplay(), !previewDisabled && !previewOccluded);
+}
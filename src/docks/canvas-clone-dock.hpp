@@ -1,4 +1,5 @@
 #pragma once
+#include "../utils/preview-throttle.hpp"
 #include "../utils/widgets/projector.hpp"
 #include "../utils/widgets/qt-display.hpp"
 #include "../utils/widgets/switching-splitter.hpp"
@@ -26,6 +27,10 @@ private:
 	std::vector<OBSProjector *> projectors;
 	std::list<OBSSource> transition_cache;
 	std::list<OBSSource> scene_cache;
+	PreviewThrottle previewThrottle;
+	bool previewDisabled = false;
+	bool previewOccluded = false;
+	bool occlusionWatched = false;
 
 	std::map<obs_source_t *, obs_weak_source_t *> replace_sources;
 	pthread_mutex_t replace_sources_mutex;
@@ -37,6 +42,7 @@ private:
 	void SceneDetectReplacedSource(obs_sceneitem_t *item, bool *change_source);
 	void RemoveSource(QString source_name);
 	void DeleteProjector(OBSProjector *projector);
+	void UpdatePreviewEnabled();
 	OBSProjector *OpenProjector(int monitor);
 	static void AddProjectorMenuMonitors(QMenu *parent, QObject *target, const char *slot);
 	static void DrawPreview(void *data, uint32_t cx, uint32_t cy);
@@ -51,6 +57,9 @@ private slots:
 	void SaveSettings(bool closing = false, QString mode = "");
 	void OpenPreviewProjector();
 
+protected:
+	void showEvent(QShowEvent *event) override;
+
 public:
 	CanvasCloneDock(obs_data_t *settings, QWidget *parent = nullptr);
 	~CanvasCloneDock();
@@ -65,4 +74,6 @@ public:
 	void reset_build_state();
 
 	void SetPanelVisible(const QString &panel_name, bool visible);
+	PreviewPolicy GetPreviewPolicy() const;
+	void SetPreviewPolicy(PreviewPolicy policy);
 };
@@ -1,6 +1,11 @@
 #include "../dialogs/name-dialog.hpp"
 #include "../utils/color.hpp"
+#include "../utils/hotkey-dispatch.hpp"
 #include "../utils/icon.hpp"
+#include "../utils/preview-texture.hpp"
+#include "../utils/registry.hpp"
+#include "../utils/scene-links.hpp"
+#include "../utils/switch-latency.hpp"
 #include "../utils/widgets/focus-scroll-spinbox.hpp"
 #include "../utils/widgets/source-tree.hpp"
 #include "canvas-dock.hpp"
@@ -23,7 +28,7 @@
 #include <QSplitter>
 #include <QToolBar>
 #include <QWidgetAction>
-#include <src/utils/obs-websocket-api.h>
+#include <src/utils/vendor-events.hpp>
 #include <util/dstr.h>
 #include <util/platform.h>
 
@@ -34,11 +39,9 @@
 std::list<CanvasDock *> canvas_docks;
 
 extern QTabBar *modesTabBar;
-extern obs_websocket_vendor vendor;
 
 CanvasDock::CanvasDock(obs_data_t *settings_, QWidget *parent)
 	: QFrame(parent),
-	  preview(new OBSQTDisplay(this)),
 	  settings(settings_),
 	  eventFilter(BuildEventFilter())
 {
@@ -130,16 +133,39 @@ CanvasDock::CanvasDock(obs_data_t *settings_, QWidget *parent)
 		signal_handler_connect(sh, "source_add", source_add, this);
 	}
 
-	LoadUI();
+	transition = new QComboBox();
+	LoadTransitions();
+	LoadScenes();
+	LogScenes();
+
+	auto pa = obs_data_get_array(settings, "projectors");
+	LoadProjectors(pa);
+	obs_data_array_release(pa);
+	preview_disabled = obs_data_get_bool(settings, "preview_disabled");
+	locked = obs_data_get_bool(settings, "preview_locked");
+	auto policy = preview_policy_from_string(obs_data_get_string(settings, "preview_policy"));
+	if (policy != PreviewPolicy::Disabled) {
+		previewThrottle.SetPolicy(policy);
+	}
+
+	obs_frontend_add_save_callback(save_load, this);
+
+	// the widgets are only built once the dock is shown, docks that stay hidden only keep the canvas running
 }
 
 CanvasDock::CanvasDock(const char *canvas_name_, QWidget *parent)
 	: QFrame(parent),
-	  preview(new OBSQTDisplay(this)),
 	  eventFilter(BuildEventFilter()),
 	  canvas_name(canvas_name_)
 {
 	LoadUI();
+	obs_frontend_add_save_callback(save_load, this);
+}
+
+void CanvasDock::showEvent(QShowEvent *event)
+{
+	LoadUI();
+	QFrame::showEvent(event);
 }
 
 bool CanvasDock::save_undo_source_enum(obs_scene_t * /* scene */, obs_sceneitem_t *item, void *p)
@@ -232,6 +258,13 @@ std::string CanvasDock::backup_scene(obs_scene_t *scene)
 
 void CanvasDock::LoadUI()
 {
+	if (canvas_split) {
+		return;
+	}
+	const uint64_t start = os_gettime_ns();
+
+	preview = new OBSQTDisplay(this);
+
 	obs_enter_graphics();
 
 	gs_render_start(true);
@@ -261,7 +294,10 @@ void CanvasDock::LoadUI()
 	if (!settings) {
 		auto canvas_combo_layout = new QHBoxLayout;
 		sceneCombo = new QComboBox;
-		connect(sceneCombo, &QComboBox::currentTextChanged, [this]() { SwitchScene(sceneCombo->currentText()); });
+		connect(sceneCombo, &QComboBox::currentTextChanged, [this]() {
+			switch_latency_request(canvas, "list");
+			SwitchScene(sceneCombo->currentText());
+		});
 		canvas_combo_layout->addWidget(sceneCombo);
 
 		auto addButton = new QPushButton;
@@ -334,8 +370,10 @@ void CanvasDock::LoadUI()
 	preview->installEventFilter(eventFilter.get());
 
 	preview->show();
-	connect(preview, &OBSQTDisplay::DisplayCreated,
-		[this]() { obs_display_add_draw_callback(preview->GetDisplay(), DrawPreview, this); });
+	connect(preview, &OBSQTDisplay::DisplayCreated, [this]() {
+		obs_display_add_draw_callback(preview->GetDisplay(), DrawPreview, this);
+		obs_display_set_enabled(preview->GetDisplay(), !preview_disabled && !previewOccluded);
+	});
 
 	previewDisabledWidget = new QFrame;
 	auto lv = new QVBoxLayout;
@@ -344,9 +382,7 @@ void CanvasDock::LoadUI()
 		new QPushButton(QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.PreviewConextMenu.Enable")));
 	connect(enablePreviewButton, &QPushButton::clicked, [this] {
 		preview_disabled = false;
-		obs_display_set_enabled(preview->GetDisplay(), true);
-		preview->setVisible(true);
-		previewDisabledWidget->setVisible(false);
+		UpdatePreviewEnabled();
 	});
 	lv->addWidget(enablePreviewButton);
 
@@ -420,6 +456,7 @@ void CanvasDock::LoadUI()
 		scenesGroupLayout->setSpacing(0);
 		scenesGroup->setLayout(scenesGroupLayout);
 		sceneList = new QListWidget();
+		sceneIndex.Bind(sceneList);
 		//sceneList->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
 		sceneList->setFrameShape(QFrame::NoFrame);
 		sceneList->setFrameShadow(QFrame::Plain);
@@ -436,6 +473,7 @@ void CanvasDock::LoadUI()
 			if (!item) {
 				return;
 			}
+			switch_latency_request(canvas, "list");
 			SwitchScene(item->text());
 			if (!item->isSelected()) {
 				item->setSelected(true);
@@ -789,7 +827,6 @@ void CanvasDock::LoadUI()
 		transitionsGroupLayout->setSpacing(0);
 		transitionsGroup->setLayout(transitionsGroupLayout);
 
-		transition = new QComboBox();
 		transitionsGroupLayout->addWidget(transition);
 		auto hl = new QHBoxLayout();
 		hl->addStretch();
@@ -815,17 +852,14 @@ void CanvasDock::LoadUI()
 				if (!obs_is_source_configurable(obs_source_get_id(tr))) {
 					action->setEnabled(false);
 				}
-				for (auto t : transitions) {
-					if (strcmp(name, obs_source_get_name(t)) == 0) {
-						action->setEnabled(false);
-						break;
-					}
+				if (transitions.Find(name)) {
+					action->setEnabled(false);
 				}
 				connect(action, &QAction::triggered, [this, tr] {
 					OBSDataAutoRelease d = obs_save_source(tr);
 					OBSSourceAutoRelease t = obs_load_private_source(d);
 					if (t) {
-						transitions.emplace_back(t);
+						transitions.Add(t);
 						auto n = QString::fromUtf8(obs_source_get_name(t));
 						transition->addItem(n);
 						transition->setCurrentText(n);
@@ -858,21 +892,14 @@ void CanvasDock::LoadUI()
 							if (name.empty()) {
 								continue;
 							}
-							bool found = false;
-							for (auto tr : transitions) {
-								if (strcmp(obs_source_get_name(tr), name.c_str()) == 0) {
-									found = true;
-									break;
-								}
-							}
-							if (found) {
+							if (transitions.Find(name.c_str())) {
 								continue;
 							}
 
 							obs_source_set_name(t, name.c_str());
 							break;
 						}
-						transitions.emplace_back(t);
+						transitions.Add(t);
 						auto n = QString::fromUtf8(obs_source_get_name(t));
 						transition->addItem(n);
 						transition->setCurrentText(n);
@@ -907,14 +934,12 @@ void CanvasDock::LoadUI()
 			}
 
 			auto n = transition->currentText().toUtf8();
-			for (auto it = transitions.begin(); it != transitions.end(); ++it) {
-				if (strcmp(n.constData(), obs_source_get_name(it->Get())) == 0) {
-					if (!obs_is_source_configurable(obs_source_get_id(it->Get()))) {
-						return;
-					}
-					transitions.erase(it);
-					break;
+			auto t = transitions.Find(n.constData());
+			if (t) {
+				if (!obs_is_source_configurable(obs_source_get_id(t))) {
+					return;
 				}
+				transitions.Remove(t);
 			}
 			transition->removeItem(transition->currentIndex());
 			if (transition->currentIndex() < 0) {
@@ -952,14 +977,7 @@ void CanvasDock::LoadUI()
 					if (name.empty()) {
 						continue;
 					}
-					bool found = false;
-					for (auto tr : transitions) {
-						if (strcmp(obs_source_get_name(tr), name.c_str()) == 0) {
-							found = true;
-							break;
-						}
-					}
-					if (found) {
+					if (transitions.Find(name.c_str())) {
 						continue;
 					}
 
@@ -990,8 +1008,6 @@ void CanvasDock::LoadUI()
 
 		canvas_split->addWidget(panel_split);
 
-		LoadTransitions();
-
 		connect(transition, &QComboBox::currentTextChanged, [this, removeButton, propsButton] {
 			auto tn = transition->currentText().toUtf8();
 			auto t = GetTransition(tn.constData());
@@ -1017,25 +1033,24 @@ void CanvasDock::LoadUI()
 				}
 			}
 		}
-		LoadScenes();
-		LogScenes();
-
-		auto pa = obs_data_get_array(settings, "projectors");
-		LoadProjectors(pa);
-		obs_data_array_release(pa);
-		preview_disabled = obs_data_get_bool(settings, "preview_disabled");
-		locked = obs_data_get_bool(settings, "preview_locked");
+		LoadSceneList();
 	}
-	obs_display_set_enabled(preview->GetDisplay(), !preview_disabled);
-	preview->setVisible(!preview_disabled);
-	previewDisabledWidget->setVisible(preview_disabled);
+	if (scene) {
+		sourceList->GetStm()->SceneChanged();
+	}
+	UpdatePreviewEnabled();
+	PreviewThrottle::WatchOcclusion(this, [this](bool occluded) {
+		previewOccluded = occluded;
+		UpdatePreviewEnabled();
+	});
 
 	connect(canvas_split, &SwitchingSplitter::splitterMoved, [this] { SaveSettings(); });
 	if (panel_split) {
 		connect(panel_split, &SwitchingSplitter::splitterMoved, [this] { SaveSettings(); });
 	}
 
-	obs_frontend_add_save_callback(save_load, this);
+	blog(LOG_INFO, "[Aitum Stream Suite] Canvas '%s' dock loaded in %.1f ms", canvas_name.c_str(),
+	     (double)(os_gettime_ns() - start) / 1000000.0);
 }
 
 bool WindowPositionValid(QRect rect)
@@ -1161,23 +1176,13 @@ void CanvasDock::DrawPreview(void *data, uint32_t cx, uint32_t cy)
 	gs_ortho(0.0f, float(sourceCX), 0.0f, float(sourceCY), -100.0f, 100.0f);
 	gs_set_viewport(x, y, (int)newCX, (int)newCY);
 	//obs_view_render(window->view);
-	if (source) {
-		obs_source_video_render(source);
-	} else {
-		obs_canvas_render(window->canvas);
-	}
+	window->previewThrottle.Render(window->canvas, source, (uint32_t)newCX, (uint32_t)newCY, sourceCX, sourceCY);
 
 	gs_set_linear_srgb(previous);
 
 	gs_ortho(float(-x), newCX + float(x), float(-y), newCY + float(y), -100.0f, 100.0f);
 	gs_reset_viewport();
 
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_technique_t *tech = gs_effect_get_technique(solid, "Solid");
-
-	gs_technique_begin(tech);
-	gs_technique_begin_pass(tech, 0);
-
 	if (window->scene && !window->locked) {
 		gs_matrix_push();
 		gs_matrix_scale3f(scale, scale, 1.0f);
@@ -1186,24 +1191,10 @@ void CanvasDock::DrawPreview(void *data, uint32_t cx, uint32_t cy)
 	}
 
 	if (window->selectionBox) {
-		if (!window->rectFill) {
-			gs_render_start(true);
-
-			gs_vertex2f(0.0f, 0.0f);
-			gs_vertex2f(1.0f, 0.0f);
-			gs_vertex2f(0.0f, 1.0f);
-			gs_vertex2f(1.0f, 1.0f);
-
-			window->rectFill = gs_render_save();
-		}
-
 		window->DrawSelectionBox(window->startPos.x * scale, window->startPos.y * scale, window->mousePos.x * scale,
-					 window->mousePos.y * scale, window->rectFill);
+					 window->mousePos.y * scale);
 	}
-	gs_load_vertexbuffer(nullptr);
-
-	gs_technique_end_pass(tech);
-	gs_technique_end(tech);
+	window->DrawOverlay();
 
 	if (window->drawSpacingHelpers) {
 		window->DrawSpacingHelpers(window->scene, (float)x, (float)y, newCX, newCY, scale, float(sourceCX),
@@ -1221,14 +1212,28 @@ CanvasDock::~CanvasDock()
 	}
 	obs_frontend_remove_save_callback(save_load, this);
 	canvas_docks.remove(this);
-	obs_display_remove_draw_callback(preview->GetDisplay(), DrawPreview, this);
+	registry_remove_canvas_dock(this);
+	hotkey_dispatch_remove_canvas(this);
+	if (preview) {
+		obs_display_remove_draw_callback(preview->GetDisplay(), DrawPreview, this);
+	}
 	SaveSettings(true);
 	obs_data_release(settings);
+	// the transition list only gets a parent once LoadUI puts it in a layout
+	if (!canvas_split) {
+		delete transition;
+	}
 	obs_enter_graphics();
 	gs_vertexbuffer_destroy(box);
-	gs_vertexbuffer_destroy(rectFill);
-	gs_vertexbuffer_destroy(circleFill);
+	gs_vertexbuffer_destroy(overlayBuffer);
+	for (auto &it : spacerLabelCache) {
+		gs_texrender_destroy(it.second.texrender);
+	}
+	spacerLabelCache.clear();
 	obs_leave_graphics();
+	preloader.Clear();
+	preview_texture_remove(canvas);
+	switch_latency_remove(canvas);
 	if (canvas) {
 		auto sh = obs_canvas_get_signal_handler(canvas);
 		if (sh) {
@@ -1248,7 +1253,7 @@ CanvasDock::~CanvasDock()
 	}
 	obs_source_release(oldTransition);
 
-	transitions.clear();
+	transitions.Clear();
 }
 
 extern obs_data_t *current_profile_config;
@@ -1256,7 +1261,7 @@ extern obs_data_t *current_profile_config;
 void CanvasDock::SaveSettings(bool closing, QString mode)
 {
 	if (!settings) {
-		if (!closing && current_profile_config) {
+		if (!closing && current_profile_config && canvas_split) {
 			auto state = canvas_split->saveState();
 			auto b64 = state.toBase64();
 			auto state_chars = b64.constData();
@@ -1314,64 +1319,68 @@ void CanvasDock::SaveSettings(bool closing, QString mode)
 		obs_data_set_array(settings, "projectors", pa);
 		obs_data_array_release(pa);
 
-		auto state = canvas_split->saveState();
-		auto b64 = state.toBase64();
-		auto state_chars = b64.constData();
-		if (mode.isEmpty() && modesTabBar) {
-			auto d = modesTabBar->tabData(modesTabBar->currentIndex());
-			if (!d.isNull() && d.isValid() && !d.toString().isEmpty()) {
-				mode = d.toString();
-			} else {
-				mode = modesTabBar->tabText(modesTabBar->currentIndex());
+		if (canvas_split) {
+			auto state = canvas_split->saveState();
+			auto b64 = state.toBase64();
+			auto state_chars = b64.constData();
+			if (mode.isEmpty() && modesTabBar) {
+				auto d = modesTabBar->tabData(modesTabBar->currentIndex());
+				if (!d.isNull() && d.isValid() && !d.toString().isEmpty()) {
+					mode = d.toString();
+				} else {
+					mode = modesTabBar->tabText(modesTabBar->currentIndex());
+				}
 			}
-		}
-		std::string setting_name = "canvas_split";
-		if (!mode.isEmpty()) {
-			setting_name += "_" + mode.toStdString();
-		}
-		obs_data_set_string(settings, setting_name.c_str(), state_chars);
-		setting_name = "canvas_split_automatic";
-		if (!mode.isEmpty()) {
-			setting_name += "_" + mode.toStdString();
-		}
-		obs_data_set_bool(settings, setting_name.c_str(), canvas_split->automaticSwitching);
-		setting_name = "canvas_split_horizontal";
-		if (!mode.isEmpty()) {
-			setting_name += "_" + mode.toStdString();
-		}
-		obs_data_set_bool(settings, setting_name.c_str(), canvas_split->orientation() == Qt::Horizontal);
-		setting_name = "canvas_split_order";
-		if (!mode.isEmpty()) {
-			setting_name += "_" + mode.toStdString();
-		}
-		obs_data_set_string(settings, setting_name.c_str(), canvas_split->savePanelOrder().toUtf8().constData());
-		if (panel_split) {
-			state = panel_split->saveState();
-			b64 = state.toBase64();
-			state_chars = b64.constData();
-			setting_name = "panel_split";
+			std::string setting_name = "canvas_split";
 			if (!mode.isEmpty()) {
 				setting_name += "_" + mode.toStdString();
 			}
 			obs_data_set_string(settings, setting_name.c_str(), state_chars);
-			setting_name = "panel_split_automatic";
+			setting_name = "canvas_split_automatic";
 			if (!mode.isEmpty()) {
 				setting_name += "_" + mode.toStdString();
 			}
-			obs_data_set_bool(settings, setting_name.c_str(), panel_split->automaticSwitching);
-			setting_name = "panel_split_horizontal";
+			obs_data_set_bool(settings, setting_name.c_str(), canvas_split->automaticSwitching);
+			setting_name = "canvas_split_horizontal";
 			if (!mode.isEmpty()) {
 				setting_name += "_" + mode.toStdString();
 			}
-			obs_data_set_bool(settings, setting_name.c_str(), panel_split->orientation() == Qt::Horizontal);
-			setting_name = "panel_split_order";
+			obs_data_set_bool(settings, setting_name.c_str(), canvas_split->orientation() == Qt::Horizontal);
+			setting_name = "canvas_split_order";
 			if (!mode.isEmpty()) {
 				setting_name += "_" + mode.toStdString();
 			}
-			obs_data_set_string(settings, setting_name.c_str(), panel_split->savePanelOrder().toUtf8().constData());
+			obs_data_set_string(settings, setting_name.c_str(), canvas_split->savePanelOrder().toUtf8().constData());
+			if (panel_split) {
+				state = panel_split->saveState();
+				b64 = state.toBase64();
+				state_chars = b64.constData();
+				setting_name = "panel_split";
+				if (!mode.isEmpty()) {
+					setting_name += "_" + mode.toStdString();
+				}
+				obs_data_set_string(settings, setting_name.c_str(), state_chars);
+				setting_name = "panel_split_automatic";
+				if (!mode.isEmpty()) {
+					setting_name += "_" + mode.toStdString();
+				}
+				obs_data_set_bool(settings, setting_name.c_str(), panel_split->automaticSwitching);
+				setting_name = "panel_split_horizontal";
+				if (!mode.isEmpty()) {
+					setting_name += "_" + mode.toStdString();
+				}
+				obs_data_set_bool(settings, setting_name.c_str(), panel_split->orientation() == Qt::Horizontal);
+				setting_name = "panel_split_order";
+				if (!mode.isEmpty()) {
+					setting_name += "_" + mode.toStdString();
+				}
+				obs_data_set_string(settings, setting_name.c_str(),
+						    panel_split->savePanelOrder().toUtf8().constData());
+			}
 		}
 
 		obs_data_set_bool(settings, "preview_disabled", preview_disabled);
+		obs_data_set_string(settings, "preview_policy", preview_policy_to_string(previewThrottle.GetPolicy()));
 		obs_data_set_bool(settings, "preview_locked", locked);
 	}
 
@@ -1755,9 +1764,9 @@ void CanvasDock::RenderSpacingHelper(int sourceIndex, vec3 &start, vec3 &end, ve
 		return;
 	}
 
-	obs_source_t *s = spacerLabel[sourceIndex];
+	SpacerLabelTexture *label = GetSpacerLabelTexture(sourceIndex, (int)px);
 	vec3 labelSize, labelPos;
-	vec3_set(&labelSize, (float)obs_source_get_width(s), (float)obs_source_get_height(s), 1.0f);
+	vec3_set(&labelSize, label ? (float)label->cx : 0.0f, label ? (float)label->cy : 0.0f, 1.0f);
 
 	vec3_div(&labelSize, &labelSize, &viewport);
 
@@ -1777,8 +1786,9 @@ void CanvasDock::RenderSpacingHelper(int sourceIndex, vec3 &start, vec3 &end, ve
 	}
 
 	DrawSpacingLine(start, end, viewport, pixelRatio);
-	SetLabelText(sourceIndex, (int)px);
-	DrawLabel(s, labelPos, viewport);
+	if (label) {
+		DrawLabel(label, labelPos, viewport);
+	}
 }
 
 void CanvasDock::DrawSpacingLine(vec3 &start, vec3 &end, vec3 &viewport, float pixelRatio)
@@ -1788,17 +1798,10 @@ void CanvasDock::DrawSpacingLine(vec3 &start, vec3 &end, vec3 &viewport, float p
 	transform.x.x = viewport.x;
 	transform.y.y = viewport.y;
 
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_technique_t *tech = gs_effect_get_technique(solid, "Solid");
-
 	QColor selColor = GetSelectionColor();
 	vec4 color;
 	vec4_set(&color, selColor.redF(), selColor.greenF(), selColor.blueF(), 1.0f);
-
-	gs_effect_set_vec4(gs_effect_get_param_by_name(solid, "color"), &color);
-
-	gs_technique_begin(tech);
-	gs_technique_begin_pass(tech, 0);
+	overlayColor = vec4_to_rgba(&color);
 
 	gs_matrix_push();
 	gs_matrix_mul(&transform);
@@ -1810,10 +1813,7 @@ void CanvasDock::DrawSpacingLine(vec3 &start, vec3 &end, vec3 &viewport, float p
 
 	gs_matrix_pop();
 
-	gs_load_vertexbuffer(nullptr);
-
-	gs_technique_end_pass(tech);
-	gs_technique_end(tech);
+	DrawOverlay();
 }
 
 config_t *CanvasDock::GetUserConfig(void)
@@ -1864,11 +1864,79 @@ void CanvasDock::SetLabelText(int sourceIndex, int px)
 	obs_source_update(s, settings);
 
 	spacerPx[sourceIndex] = px;
+	spacerPxFrame[sourceIndex] = obs_get_video_frame_time();
 }
 
-void CanvasDock::DrawLabel(OBSSource source, vec3 &pos, vec3 &viewport)
+static std::string spacer_label_key(obs_source_t *s, int px)
 {
-	if (!source) {
+	OBSDataAutoRelease settings = obs_source_get_settings(s);
+	OBSDataAutoRelease font = obs_data_get_obj(settings, "font");
+	std::string key = std::to_string(px) + " px|";
+	key += obs_data_get_string(font, "face");
+	key += "|" + std::to_string(obs_data_get_int(font, "size"));
+	key += "|" + std::to_string(obs_data_get_int(font, "flags"));
+	return key;
+}
+
+CanvasDock::SpacerLabelTexture *CanvasDock::GetSpacerLabelTexture(int sourceIndex, int px)
+{
+	obs_source_t *s = spacerLabel[sourceIndex];
+	std::string key = spacer_label_key(s, px);
+	auto it = spacerLabelCache.find(key);
+	if (it != spacerLabelCache.end()) {
+		it->second.used = ++spacerLabelUse;
+		spacerLabelKey[sourceIndex] = key;
+		return &it->second;
+	}
+
+	SetLabelText(sourceIndex, px);
+	if (spacerPxFrame[sourceIndex] == obs_get_video_frame_time()) {
+		// the text update is applied on the next video tick, keep the previous label until the size matches the new text
+		it = spacerLabelCache.find(spacerLabelKey[sourceIndex]);
+		return it == spacerLabelCache.end() ? nullptr : &it->second;
+	}
+	uint32_t cx = obs_source_get_width(s);
+	uint32_t cy = obs_source_get_height(s);
+	if (!cx || !cy) {
+		return nullptr;
+	}
+
+	SpacerLabelTexture label;
+	if (spacerLabelCache.size() >= SPACER_LABEL_CACHE_SIZE) {
+		auto oldest = std::min_element(spacerLabelCache.begin(), spacerLabelCache.end(),
+					       [](const auto &a, const auto &b) { return a.second.used < b.second.used; });
+		label.texrender = oldest->second.texrender;
+		spacerLabelCache.erase(oldest);
+	} else {
+		label.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+	}
+
+	gs_texrender_reset(label.texrender);
+	if (!gs_texrender_begin(label.texrender, cx, cy)) {
+		gs_texrender_destroy(label.texrender);
+		return nullptr;
+	}
+	vec4 clear_color;
+	vec4_zero(&clear_color);
+	gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+	gs_blend_state_push();
+	gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	obs_source_video_render(s);
+	gs_blend_state_pop();
+	gs_texrender_end(label.texrender);
+
+	label.cx = cx;
+	label.cy = cy;
+	label.used = ++spacerLabelUse;
+	spacerLabelKey[sourceIndex] = key;
+	return &(spacerLabelCache[key] = label);
+}
+
+void CanvasDock::DrawLabel(const SpacerLabelTexture *label, vec3 &pos, vec3 &viewport)
+{
+	gs_texture_t *tex = gs_texrender_get_texture(label->texrender);
+	if (!tex) {
 		return;
 	}
 
@@ -1877,31 +1945,132 @@ void CanvasDock::DrawLabel(OBSSource source, vec3 &pos, vec3 &viewport)
 	gs_matrix_push();
 	gs_matrix_identity();
 	gs_matrix_translate(&pos);
-	obs_source_video_render(source);
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw")) {
+		gs_draw_sprite(tex, 0, label->cx, label->cy);
+	}
+	gs_blend_state_pop();
 	gs_matrix_pop();
 }
 
-void CanvasDock::DrawLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale)
+void CanvasDock::AddOverlayTriangle(const vec3 &a, const vec3 &b, const vec3 &c)
 {
-	float ySide = (y1 == y2) ? (y1 < 0.5f ? 1.0f : -1.0f) : 0.0f;
-	float xSide = (x1 == x2) ? (x1 < 0.5f ? 1.0f : -1.0f) : 0.0f;
+	overlayPoints.push_back(a);
+	overlayPoints.push_back(b);
+	overlayPoints.push_back(c);
+	overlayColors.insert(overlayColors.end(), 3, overlayColor);
+}
 
-	gs_render_start(true);
+void CanvasDock::AddOverlayQuad(float x, float y, float axisX, float axisY, float sideX, float sideY)
+{
+	if ((axisX == 0.0f && axisY == 0.0f) || (sideX == 0.0f && sideY == 0.0f)) {
+		return;
+	}
 
-	gs_vertex2f(x1, y1);
-	gs_vertex2f(x1 + (xSide * (thickness / scale.x)), y1 + (ySide * (thickness / scale.y)));
-	gs_vertex2f(x2 + (xSide * (thickness / scale.x)), y2 + (ySide * (thickness / scale.y)));
-	gs_vertex2f(x2, y2);
-	gs_vertex2f(x1, y1);
+	matrix4 transform;
+	gs_matrix_get(&transform);
 
-	gs_vertbuffer_t *line = gs_render_save();
+	vec3 corners[4];
+	vec3_set(&corners[0], x, y, 0.0f);
+	vec3_set(&corners[1], x + axisX, y + axisY, 0.0f);
+	vec3_set(&corners[2], x + sideX, y + sideY, 0.0f);
+	vec3_set(&corners[3], x + axisX + sideX, y + axisY + sideY, 0.0f);
+	for (auto &corner : corners) {
+		vec3_transform(&corner, &corner, &transform);
+	}
 
-	gs_load_vertexbuffer(line);
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_vertexbuffer_destroy(line);
+	AddOverlayTriangle(corners[0], corners[1], corners[2]);
+	AddOverlayTriangle(corners[1], corners[3], corners[2]);
+}
+
+void CanvasDock::AddOverlayCircle()
+{
+	matrix4 transform;
+	gs_matrix_get(&transform);
+
+	vec3 center, prev, next;
+	vec3_set(&center, 0.5f, 0.5f, 0.0f);
+	vec3_transform(&center, &center, &transform);
+
+	float angle = 180.0f;
+	vec3_set(&prev, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0.0f);
+	vec3_transform(&prev, &prev, &transform);
+	for (int i = 0, l = 40; i < l; i++) {
+		angle += 360.0f / (float)l;
+		vec3_set(&next, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0.0f);
+		vec3_transform(&next, &next, &transform);
+		AddOverlayTriangle(center, prev, next);
+		prev = next;
+	}
+}
+
+void CanvasDock::DrawOverlay()
+{
+	const size_t count = overlayPoints.size();
+	if (!count) {
+		return;
+	}
+
+	if (!overlayBuffer || count > overlayCapacity) {
+		gs_vertexbuffer_destroy(overlayBuffer);
+		overlayCapacity = 1024;
+		while (overlayCapacity < count) {
+			overlayCapacity *= 2;
+		}
+		struct gs_vb_data *vbd = gs_vbdata_create();
+		vbd->num = overlayCapacity;
+		vbd->points = (struct vec3 *)bzalloc(sizeof(struct vec3) * overlayCapacity);
+		vbd->colors = (uint32_t *)bzalloc(sizeof(uint32_t) * overlayCapacity);
+		overlayBuffer = gs_vertexbuffer_create(vbd, GS_DYNAMIC);
+		if (!overlayBuffer) {
+			overlayCapacity = 0;
+			overlayPoints.clear();
+			overlayColors.clear();
+			return;
+		}
+	}
+
+	struct gs_vb_data *vbd = gs_vertexbuffer_get_data(overlayBuffer);
+	memcpy(vbd->points, overlayPoints.data(), sizeof(struct vec3) * count);
+	memcpy(vbd->colors, overlayColors.data(), sizeof(uint32_t) * count);
+	gs_vertexbuffer_flush(overlayBuffer);
+
+	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
+	gs_technique_t *tech = gs_effect_get_technique(solid, "SolidColored");
+
+	vec4 white;
+	vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+	gs_effect_set_vec4(gs_effect_get_param_by_name(solid, "color"), &white);
+
+	gs_technique_begin(tech);
+	gs_technique_begin_pass(tech, 0);
+
+	gs_matrix_push();
+	gs_matrix_identity();
+	gs_load_vertexbuffer(overlayBuffer);
+	gs_draw(GS_TRIS, 0, (uint32_t)count);
+	gs_load_vertexbuffer(nullptr);
+	gs_matrix_pop();
+
+	gs_technique_end_pass(tech);
+	gs_technique_end(tech);
+
+	overlayPoints.clear();
+	overlayColors.clear();
 }
 
-void CanvasDock::DrawRotationHandle(gs_vertbuffer_t *circle, float rot, float pixelRatio)
+void CanvasDock::DrawLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale)
+{
+	float ySide = (y1 == y2) ? (y1 < 0.5f ? 1.0f : -1.0f) : 0.0f;
+	float xSide = (x1 == x2) ? (x1 < 0.5f ? 1.0f : -1.0f) : 0.0f;
+
+	AddOverlayQuad(x1, y1, x2 - x1, y2 - y1, xSide * (thickness / scale.x), ySide * (thickness / scale.y));
+}
+
+void CanvasDock::DrawRotationHandle(float rot, float pixelRatio)
 {
 	struct vec3 pos;
 	vec3_set(&pos, 0.5f, 0.0f, 0.0f);
@@ -1910,18 +2079,6 @@ void CanvasDock::DrawRotationHandle(gs_vertbuffer_t *circle, float rot, float pi
 	gs_matrix_get(&matrix);
 	vec3_transform(&pos, &pos, &matrix);
 
-	gs_render_start(true);
-
-	gs_vertex2f(0.5f - 0.34f / HANDLE_RADIUS, 0.5f);
-	gs_vertex2f(0.5f - 0.34f / HANDLE_RADIUS, -2.0f);
-	gs_vertex2f(0.5f + 0.34f / HANDLE_RADIUS, -2.0f);
-	gs_vertex2f(0.5f + 0.34f / HANDLE_RADIUS, 0.5f);
-	gs_vertex2f(0.5f - 0.34f / HANDLE_RADIUS, 0.5f);
-
-	gs_vertbuffer_t *line = gs_render_save();
-
-	gs_load_vertexbuffer(line);
-
 	gs_matrix_push();
 	gs_matrix_identity();
 	gs_matrix_translate(&pos);
@@ -1930,15 +2087,13 @@ void CanvasDock::DrawRotationHandle(gs_vertbuffer_t *circle, float rot, float pi
 	gs_matrix_translate3f(-HANDLE_RADIUS * 1.5f * pixelRatio, -HANDLE_RADIUS * 1.5f * pixelRatio, 0.0f);
 	gs_matrix_scale3f(HANDLE_RADIUS * 3 * pixelRatio, HANDLE_RADIUS * 3 * pixelRatio, 1.0f);
 
-	gs_draw(GS_TRISTRIP, 0, 0);
+	AddOverlayQuad(0.5f - 0.34f / HANDLE_RADIUS, -2.0f, 0.68f / HANDLE_RADIUS, 0.0f, 0.0f, 2.5f);
 
 	gs_matrix_translate3f(0.0f, -HANDLE_RADIUS * 2 / 3, 0.0f);
 
-	gs_load_vertexbuffer(circle);
-	gs_draw(GS_TRISTRIP, 0, 0);
+	AddOverlayCircle();
 
 	gs_matrix_pop();
-	gs_vertexbuffer_destroy(line);
 }
 
 void CanvasDock::DrawStripedLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale)
@@ -1957,8 +2112,6 @@ void CanvasDock::DrawStripedLine(float x1, float y1, float x2, float y2, float t
 	float offY = (y2 - y1) / dist;
 
 	for (int i = 0, l = (int)ceil(dist / 15.0); i < l; i++) {
-		gs_render_start(true);
-
 		float xx1 = x1 + (float)i * 15.0f * offX;
 		float yy1 = y1 + (float)i * 15.0f * offY;
 
@@ -1977,16 +2130,7 @@ void CanvasDock::DrawStripedLine(float x1, float y1, float x2, float y2, float t
 			dy = std::max(yy1 + 7.5f * offY, y2);
 		}
 
-		gs_vertex2f(xx1, yy1);
-		gs_vertex2f(xx1 + (xSide * (thickness / scale.x)), yy1 + (ySide * (thickness / scale.y)));
-		gs_vertex2f(dx, dy);
-		gs_vertex2f(dx + (xSide * (thickness / scale.x)), dy + (ySide * (thickness / scale.y)));
-
-		gs_vertbuffer_t *line = gs_render_save();
-
-		gs_load_vertexbuffer(line);
-		gs_draw(GS_TRISTRIP, 0, 0);
-		gs_vertexbuffer_destroy(line);
+		AddOverlayQuad(xx1, yy1, dx - xx1, dy - yy1, xSide * (thickness / scale.x), ySide * (thickness / scale.y));
 	}
 }
 
@@ -1995,30 +2139,15 @@ void CanvasDock::DrawRect(float thickness, vec2 scale)
 	if (scale.x <= 0.0f || scale.y <= 0.0f || thickness <= 0.0f) {
 		return;
 	}
-	gs_render_start(true);
-
-	gs_vertex2f(0.0f, 0.0f);
-	gs_vertex2f(0.0f + (thickness / scale.x), 0.0f);
-	gs_vertex2f(0.0f, 1.0f);
-	gs_vertex2f(0.0f + (thickness / scale.x), 1.0f);
-	gs_vertex2f(0.0f, 1.0f - (thickness / scale.y));
-	gs_vertex2f(1.0f, 1.0f);
-	gs_vertex2f(1.0f, 1.0f - (thickness / scale.y));
-	gs_vertex2f(1.0f - (thickness / scale.x), 1.0f);
-	gs_vertex2f(1.0f, 0.0f);
-	gs_vertex2f(1.0f - (thickness / scale.x), 0.0f);
-	gs_vertex2f(1.0f, 0.0f + (thickness / scale.y));
-	gs_vertex2f(0.0f, 0.0f);
-	gs_vertex2f(0.0f, 0.0f + (thickness / scale.y));
-
-	gs_vertbuffer_t *rect = gs_render_save();
-
-	gs_load_vertexbuffer(rect);
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_vertexbuffer_destroy(rect);
+	const float tx = thickness / scale.x;
+	const float ty = thickness / scale.y;
+	AddOverlayQuad(0.0f, 0.0f, 0.0f, 1.0f, tx, 0.0f);
+	AddOverlayQuad(1.0f, 0.0f, 0.0f, 1.0f, -tx, 0.0f);
+	AddOverlayQuad(0.0f, 0.0f, 1.0f, 0.0f, 0.0f, ty);
+	AddOverlayQuad(0.0f, 1.0f, 1.0f, 0.0f, 0.0f, -ty);
 }
 
-bool CanvasDock::DrawSelectionBox(float x1, float y1, float x2, float y2, gs_vertbuffer_t *rect_fill)
+bool CanvasDock::DrawSelectionBox(float x1, float y1, float x2, float y2)
 {
 	float pixelRatio = GetDevicePixelRatio();
 
@@ -2027,9 +2156,6 @@ bool CanvasDock::DrawSelectionBox(float x1, float y1, float x2, float y2, gs_ver
 	y1 = std::round(y1);
 	y2 = std::round(y2);
 
-	gs_effect_t *eff = gs_get_effect();
-	gs_eparam_t *colParam = gs_effect_get_param_by_name(eff, "color");
-
 	vec4 fillColor;
 	vec4_set(&fillColor, 0.7f, 0.7f, 0.7f, 0.5f);
 
@@ -2045,11 +2171,10 @@ bool CanvasDock::DrawSelectionBox(float x1, float y1, float x2, float y2, gs_ver
 	gs_matrix_translate3f(x1, y1, 0.0f);
 	gs_matrix_scale3f(x2 - x1, y2 - y1, 1.0f);
 
-	gs_effect_set_vec4(colParam, &fillColor);
-	gs_load_vertexbuffer(rect_fill);
-	gs_draw(GS_TRISTRIP, 0, 0);
+	overlayColor = vec4_to_rgba(&fillColor);
+	AddOverlayQuad(0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f);
 
-	gs_effect_set_vec4(colParam, &borderColor);
+	overlayColor = vec4_to_rgba(&borderColor);
 	DrawRect(HANDLE_RADIUS * pixelRatio / 2, scale);
 
 	gs_matrix_pop();
@@ -2159,23 +2284,20 @@ bool CanvasDock::DrawSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, voi
 	obs_sceneitem_crop crop;
 	obs_sceneitem_get_crop(item, &crop);
 
-	gs_effect_t *eff = gs_get_effect();
-	gs_eparam_t *colParam = gs_effect_get_param_by_name(eff, "color");
-
-	gs_effect_set_vec4(colParam, &red);
+	window->overlayColor = vec4_to_rgba(&red);
 
 	if (obs_sceneitem_get_bounds_type(item) == OBS_BOUNDS_NONE && crop_enabled(&crop)) {
-#define DRAW_SIDE(side, x1, y1, x2, y2)                                                   \
-	if (hovered && !selected) {                                                       \
-		gs_effect_set_vec4(colParam, &blue);                                      \
-		DrawLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale);        \
-	} else if (crop.side > 0) {                                                       \
-		gs_effect_set_vec4(colParam, &green);                                     \
-		DrawStripedLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale); \
-	} else {                                                                          \
-		DrawLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale);        \
-	}                                                                                 \
-	gs_effect_set_vec4(colParam, &red);
+#define DRAW_SIDE(side, x1, y1, x2, y2)                                                           \
+	if (hovered && !selected) {                                                               \
+		window->overlayColor = vec4_to_rgba(&blue);                                       \
+		window->DrawLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale);        \
+	} else if (crop.side > 0) {                                                               \
+		window->overlayColor = vec4_to_rgba(&green);                                      \
+		window->DrawStripedLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale); \
+	} else {                                                                                  \
+		window->DrawLine(x1, y1, x2, y2, HANDLE_RADIUS *pixelRatio / 2, boxScale);        \
+	}                                                                                         \
+	window->overlayColor = vec4_to_rgba(&red);
 
 		DRAW_SIDE(left, 0.0f, 0.0f, 0.0f, 1.0f);
 		DRAW_SIDE(top, 0.0f, 0.0f, 1.0f, 0.0f);
@@ -2184,41 +2306,26 @@ bool CanvasDock::DrawSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, voi
 #undef DRAW_SIDE
 	} else {
 		if (!selected) {
-			gs_effect_set_vec4(colParam, &blue);
-			DrawRect(HANDLE_RADIUS * pixelRatio / 2, boxScale);
+			window->overlayColor = vec4_to_rgba(&blue);
+			window->DrawRect(HANDLE_RADIUS * pixelRatio / 2, boxScale);
 		} else {
-			DrawRect(HANDLE_RADIUS * pixelRatio / 2, boxScale);
+			window->DrawRect(HANDLE_RADIUS * pixelRatio / 2, boxScale);
 		}
 	}
 
-	gs_load_vertexbuffer(window->box);
-	gs_effect_set_vec4(colParam, &red);
+	window->overlayColor = vec4_to_rgba(&red);
 
 	if (selected) {
-		DrawSquareAtPos(0.0f, 0.0f, pixelRatio);
-		DrawSquareAtPos(0.0f, 1.0f, pixelRatio);
-		DrawSquareAtPos(1.0f, 0.0f, pixelRatio);
-		DrawSquareAtPos(1.0f, 1.0f, pixelRatio);
-		DrawSquareAtPos(0.5f, 0.0f, pixelRatio);
-		DrawSquareAtPos(0.0f, 0.5f, pixelRatio);
-		DrawSquareAtPos(0.5f, 1.0f, pixelRatio);
-		DrawSquareAtPos(1.0f, 0.5f, pixelRatio);
-
-		if (!window->circleFill) {
-			gs_render_start(true);
-
-			float angle = 180;
-			for (int i = 0, l = 40; i < l; i++) {
-				gs_vertex2f(sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
-				angle += 360.0f / (float)l;
-				gs_vertex2f(sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
-				gs_vertex2f(0.5f, 1.0f);
-			}
+		window->DrawSquareAtPos(0.0f, 0.0f, pixelRatio);
+		window->DrawSquareAtPos(0.0f, 1.0f, pixelRatio);
+		window->DrawSquareAtPos(1.0f, 0.0f, pixelRatio);
+		window->DrawSquareAtPos(1.0f, 1.0f, pixelRatio);
+		window->DrawSquareAtPos(0.5f, 0.0f, pixelRatio);
+		window->DrawSquareAtPos(0.0f, 0.5f, pixelRatio);
+		window->DrawSquareAtPos(0.5f, 1.0f, pixelRatio);
+		window->DrawSquareAtPos(1.0f, 0.5f, pixelRatio);
 
-			window->circleFill = gs_render_save();
-		}
-
-		DrawRotationHandle(window->circleFill, obs_sceneitem_get_rot(item) + window->groupRot, pixelRatio);
+		window->DrawRotationHandle(obs_sceneitem_get_rot(item) + window->groupRot, pixelRatio);
 	}
 
 	gs_matrix_pop();
@@ -2261,7 +2368,7 @@ void CanvasDock::DrawSquareAtPos(float x, float y, float pixelRatio)
 
 	gs_matrix_translate3f(-HANDLE_RADIUS * pixelRatio, -HANDLE_RADIUS * pixelRatio, 0.0f);
 	gs_matrix_scale3f(HANDLE_RADIUS * pixelRatio * 2, HANDLE_RADIUS * pixelRatio * 2, 1.0f);
-	gs_draw(GS_TRISTRIP, 0, 0);
+	AddOverlayQuad(0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f);
 
 	gs_matrix_pop();
 }
@@ -2273,6 +2380,7 @@ obs_sceneitem_t *CanvasDock::GetCurrentSceneItem()
 
 int CanvasDock::GetTopSelectedSourceItem()
 {
+	sourceList->FlushSceneChanged();
 	QModelIndexList selectedItems = sourceList->selectionModel()->selectedIndexes();
 	return selectedItems.count() ? selectedItems[0].row() : -1;
 }
@@ -2305,6 +2413,7 @@ void CanvasDock::ChangeSceneIndex(bool relative, int offset, int invalidIdx)
 	}
 	item->setSelected(true);
 	sceneList->blockSignals(false);
+	UpdatePreload();
 }
 
 QListWidget *CanvasDock::GetGlobalScenesList()
@@ -2368,34 +2477,17 @@ void CanvasDock::AddScene(QString duplicate, bool ask_name)
 			new_scene = obs_scene_get_source(ns);
 			obs_source_load(new_scene);
 
-			std::string ssn = obs_canvas_get_name(canvas);
-			ssn += " ";
-			ssn += obs_frontend_get_locale_string("Basic.Hotkeys.SelectScene");
-			obs_hotkey_register_source(
-				new_scene, "OBSBasic.SelectScene", ssn.c_str(),
-				[](void *data, obs_hotkey_id, obs_hotkey_t *key, bool pressed) {
-					if (!pressed) {
-						return;
-					}
-					auto p = (CanvasDock *)data;
-					auto potential_source = (obs_weak_source_t *)obs_hotkey_get_registerer(key);
-					OBSSourceAutoRelease source = obs_weak_source_get_source(potential_source);
-					if (source) {
-						auto sn = QString::fromUtf8(obs_source_get_name(source));
-						QMetaObject::invokeMethod(p, "SwitchScene", Q_ARG(QString, sn), Q_ARG(bool, true));
-					}
-				},
-				this);
+			hotkey_dispatch_add_scene(this, new_scene);
 			auto sh = obs_source_get_signal_handler(new_scene);
 			signal_handler_connect(sh, "rename", source_rename, this);
 			signal_handler_connect(sh, "remove", source_remove, this);
 		}
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_SCENES)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "canvas", obs_canvas_get_name(canvas));
 			obs_data_set_string(d, "name", obs_source_get_name(new_scene));
 			obs_data_set_string(d, "uuid", obs_source_get_uuid(new_scene));
-			obs_websocket_vendor_emit_event(vendor, "scene_added", d);
+			vendor_emit_event(VENDOR_EVENT_SCENES, "scene_added", d);
 			obs_data_release(d);
 		}
 		auto sn = QString::fromUtf8(obs_source_get_name(new_scene));
@@ -2422,12 +2514,12 @@ void CanvasDock::RemoveScene(const QString &sceneName)
 	mb.setDefaultButton(QMessageBox::NoButton);
 	if (mb.exec() == QMessageBox::Yes) {
 		obs_source_remove(s);
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_SCENES)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "canvas", obs_canvas_get_name(canvas));
 			obs_data_set_string(d, "name", obs_source_get_name(s));
 			obs_data_set_string(d, "uuid", obs_source_get_uuid(s));
-			obs_websocket_vendor_emit_event(vendor, "scene_removed", d);
+			vendor_emit_event(VENDOR_EVENT_SCENES, "scene_removed", d);
 			obs_data_release(d);
 		}
 	}
@@ -2437,15 +2529,29 @@ void CanvasDock::RemoveScene(const QString &sceneName)
 
 void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 {
-	auto s = scene_name.isEmpty() ? nullptr : obs_canvas_get_source_by_name(canvas, scene_name.toUtf8().constData());
-	if (s == obs_scene_get_source(scene) || (!obs_source_is_scene(s) && !scene_name.isEmpty())) {
-		obs_source_release(s);
+	OBSSourceAutoRelease s = scene_name.isEmpty() ? nullptr
+						     : obs_canvas_get_source_by_name(canvas, scene_name.toUtf8().constData());
+	if (!s && !scene_name.isEmpty()) {
+		switch_latency_cancel(canvas);
+		return;
+	}
+	SwitchToScene(s.Get(), transition);
+}
+
+void CanvasDock::SwitchToScene(obs_source_t *s, bool transition)
+{
+	if (s == obs_scene_get_source(scene) || (s && !obs_source_is_scene(s))) {
+		switch_latency_cancel(canvas);
 		return;
 	}
+	const QString scene_name = s ? QString::fromUtf8(obs_source_get_name(s)) : QString();
 	auto oldSource = obs_scene_get_source(scene);
 	auto sh = oldSource ? obs_source_get_signal_handler(oldSource) : nullptr;
 	if (sh) {
 		signal_handler_disconnect(sh, "item_add", SceneItemAdded, this);
+		signal_handler_disconnect(sh, "item_remove", SceneItemRemoved, this);
+		signal_handler_disconnect(sh, "item_visible", SceneItemVisible, this);
+		signal_handler_disconnect(sh, "item_locked", SceneItemLocked, this);
 		signal_handler_disconnect(sh, "reorder", SceneReordered, this);
 		signal_handler_disconnect(sh, "refresh", SceneRefreshed, this);
 	}
@@ -2466,6 +2572,7 @@ void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 				if (SwapTransition(override_transition)) {
 					obs_source_release(oldSource);
 					oldSource = obs_weak_source_get_source(source);
+					// connected only while the override is on the channel
 					signal_handler_t *handler = obs_source_get_signal_handler(oldSource);
 					signal_handler_connect(handler, "transition_stop", transition_override_stop, this);
 				}
@@ -2483,6 +2590,7 @@ void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 					obs_transition_set(oldSource, obs_scene_get_source(scene));
 				}
 				obs_source_release(sourceA);
+				switch_latency_watch_transition(canvas, oldSource);
 				if (transition) {
 					obs_transition_start(oldSource, OBS_TRANSITION_MODE_AUTO, duration, s);
 				} else {
@@ -2504,11 +2612,17 @@ void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 			}
 		}
 	}
+	if (s) {
+		switch_latency_applied(canvas);
+	}
 	scene = obs_scene_from_source(s);
 	if (scene) {
 		sh = obs_source_get_signal_handler(s);
 		if (sh) {
 			signal_handler_connect(sh, "item_add", SceneItemAdded, this);
+			signal_handler_connect(sh, "item_remove", SceneItemRemoved, this);
+			signal_handler_connect(sh, "item_visible", SceneItemVisible, this);
+			signal_handler_connect(sh, "item_locked", SceneItemLocked, this);
 			signal_handler_connect(sh, "reorder", SceneReordered, this);
 			signal_handler_connect(sh, "refresh", SceneRefreshed, this);
 		}
@@ -2522,16 +2636,10 @@ void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 	//}
 	if (!scene_name.isEmpty()) {
 		if (sceneList) {
-			QListWidgetItem *item = sceneList->currentItem();
-			if (!item || item->text() != scene_name) {
-				for (int i = 0; i < sceneList->count(); i++) {
-					item = sceneList->item(i);
-					if (item->text() == scene_name) {
-						sceneList->setCurrentRow(i);
-						item->setSelected(true);
-						break;
-					}
-				}
+			auto item = sceneIndex.FindByName(scene_name);
+			if (item && sceneList->currentItem() != item) {
+				sceneList->setCurrentItem(item);
+				item->setSelected(true);
 			}
 		}
 		if (sceneCombo) {
@@ -2541,19 +2649,50 @@ void CanvasDock::SwitchScene(const QString &scene_name, bool transition)
 			}
 		}
 	}
-	sourceList->GetStm()->SceneChanged();
+	if (sourceList) {
+		sourceList->QueueSceneChanged();
+	}
 
-	obs_source_release(s);
-	if (vendor && oldName != currentSceneName) {
+	if (vendor_event_wanted(VENDOR_EVENT_SCENES) && oldName != currentSceneName) {
 		const auto d = obs_data_create();
 		obs_data_set_int(d, "width", canvas_width);
 		obs_data_set_int(d, "height", canvas_height);
 		obs_data_set_string(d, "canvas", obs_canvas_get_name(canvas));
 		obs_data_set_string(d, "old_scene", oldName.toUtf8().constData());
 		obs_data_set_string(d, "new_scene", currentSceneName.toUtf8().constData());
-		obs_websocket_vendor_emit_event(vendor, "switch_scene", d);
+		vendor_emit_event(VENDOR_EVENT_SCENES, "switch_scene", d);
 		obs_data_release(d);
 	}
+	UpdatePreload();
+}
+
+static obs_data_t *scene_change_data(CanvasDock *window, obs_scene_t *scene, const char *change)
+{
+	auto d = obs_data_create();
+	obs_data_set_string(d, "canvas", obs_canvas_get_name(window->GetCanvas()));
+	obs_data_set_string(d, "canvas_uuid", obs_canvas_get_uuid(window->GetCanvas()));
+	obs_source_t *scene_source = obs_scene_get_source(scene);
+	obs_data_set_string(d, "scene", obs_source_get_name(scene_source));
+	obs_data_set_string(d, "scene_uuid", obs_source_get_uuid(scene_source));
+	obs_data_set_string(d, "change", change);
+	return d;
+}
+
+static void emit_scene_item_changed(CanvasDock *window, calldata_t *params, const char *change)
+{
+	if (!vendor_event_wanted(VENDOR_EVENT_SCENE_ITEMS))
+		return;
+	obs_scene_t *scene = (obs_scene_t *)calldata_ptr(params, "scene");
+	obs_sceneitem_t *item = (obs_sceneitem_t *)calldata_ptr(params, "item");
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	auto d = scene_change_data(window, scene, change);
+	obs_data_set_int(d, "item_id", obs_sceneitem_get_id(item));
+	obs_data_set_string(d, "source", obs_source_get_name(source));
+	obs_data_set_string(d, "source_uuid", obs_source_get_uuid(source));
+	obs_data_set_bool(d, "visible", obs_sceneitem_visible(item));
+	obs_data_set_bool(d, "locked", obs_sceneitem_locked(item));
+	vendor_emit_event(VENDOR_EVENT_SCENE_ITEMS, "scene_item_changed", d);
+	obs_data_release(d);
 }
 
 void CanvasDock::SceneItemAdded(void *data, calldata_t *params)
@@ -2564,6 +2703,22 @@ void CanvasDock::SceneItemAdded(void *data, calldata_t *params)
 
 	QMetaObject::invokeMethod(window, "AddSceneItem", Qt::QueuedConnection, Q_ARG(OBSSceneItem, OBSSceneItem(item)),
 				  Q_ARG(bool, undoing));
+	emit_scene_item_changed(window, params, "added");
+}
+
+void CanvasDock::SceneItemRemoved(void *data, calldata_t *params)
+{
+	emit_scene_item_changed(static_cast<CanvasDock *>(data), params, "removed");
+}
+
+void CanvasDock::SceneItemVisible(void *data, calldata_t *params)
+{
+	emit_scene_item_changed(static_cast<CanvasDock *>(data), params, "visible");
+}
+
+void CanvasDock::SceneItemLocked(void *data, calldata_t *params)
+{
+	emit_scene_item_changed(static_cast<CanvasDock *>(data), params, "locked");
 }
 
 void CanvasDock::SceneReordered(void *data, calldata_t *params)
@@ -2572,6 +2727,25 @@ void CanvasDock::SceneReordered(void *data, calldata_t *params)
 
 	obs_scene_t *scene = (obs_scene_t *)calldata_ptr(params, "scene");
 
+	if (vendor_event_wanted(VENDOR_EVENT_SCENE_ITEMS)) {
+		auto d = scene_change_data(window, scene, "reordered");
+		auto ia = obs_data_array_create();
+		obs_scene_enum_items(
+			scene,
+			[](obs_scene_t *, obs_sceneitem_t *item, void *param) {
+				auto i = obs_data_create();
+				obs_data_set_int(i, "item_id", obs_sceneitem_get_id(item));
+				obs_data_array_push_back((obs_data_array_t *)param, i);
+				obs_data_release(i);
+				return true;
+			},
+			ia);
+		obs_data_set_array(d, "items", ia);
+		obs_data_array_release(ia);
+		vendor_emit_event(VENDOR_EVENT_SCENE_ITEMS, "scene_item_changed", d);
+		obs_data_release(d);
+	}
+
 	QMetaObject::invokeMethod(window, "ReorderSources", Qt::QueuedConnection, Q_ARG(OBSScene, OBSScene(scene)));
 }
 
@@ -2586,15 +2760,25 @@ void CanvasDock::SceneRefreshed(void *data, calldata_t *params)
 
 obs_source_t *CanvasDock::GetTransition(const char *transition_name)
 {
-	if (!transition_name || !strlen(transition_name)) {
-		return nullptr;
-	}
-	for (auto transition : transitions) {
-		if (strcmp(transition_name, obs_source_get_name(transition)) == 0) {
-			return transition;
-		}
-	}
-	return nullptr;
+	return transitions.Find(transition_name);
+}
+
+void CanvasDock::PrepareTransitions()
+{
+	std::vector<std::string> names;
+	obs_canvas_enum_scenes(
+		canvas,
+		[](void *param, obs_source_t *src) {
+			auto names = (std::vector<std::string> *)param;
+			OBSDataAutoRelease ps = obs_source_get_private_settings(src);
+			const char *name = obs_data_get_string(ps, "transition");
+			if (name && *name) {
+				names->emplace_back(name);
+			}
+			return true;
+		},
+		&names);
+	transitions.Prepare(names, canvas_width, canvas_height);
 }
 
 bool CanvasDock::SwapTransition(obs_source_t *newTransition)
@@ -2957,6 +3141,7 @@ void CanvasDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 		OBSSourceAutoRelease source = obs_canvas_get_source_by_name(canvas, scene_name.c_str());
 		OBSDataAutoRelease ps = obs_source_get_private_settings(source);
 		obs_data_set_string(ps, "transition", "");
+		PrepareTransitions();
 	});
 
 	for (auto t : transitions) {
@@ -2974,6 +3159,7 @@ void CanvasDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 			OBSSourceAutoRelease source = obs_canvas_get_source_by_name(canvas, scene_name.c_str());
 			OBSDataAutoRelease ps = obs_source_get_private_settings(source);
 			obs_data_set_string(ps, "transition", a2->text().toUtf8().constData());
+			PrepareTransitions();
 		});
 	}
 
@@ -2986,11 +3172,13 @@ void CanvasDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 	auto linkedScenesMenu = menu.addMenu(QString::fromUtf8(obs_module_text("LinkedScenes")));
 	connect(linkedScenesMenu, &QMenu::aboutToShow, [linkedScenesMenu, this] {
 		linkedScenesMenu->clear();
+		const char *canvas_name = obs_canvas_get_name(canvas);
+		scene_links_adopt(canvas_name, canvas_width, canvas_height);
+		const auto current = sceneList->currentItem() ? sceneList->currentItem()->text().toStdString() : std::string();
 		struct obs_frontend_source_list scenes = {};
 		obs_frontend_get_scenes(&scenes);
 		for (size_t i = 0; i < scenes.sources.num; i++) {
 			obs_source_t *src = scenes.sources.array[i];
-			obs_data_t *settings = obs_source_get_settings(src);
 
 			auto name = QString::fromUtf8(obs_source_get_name(src));
 			auto *checkBox = new QCheckBox(name, linkedScenesMenu);
@@ -3005,35 +3193,9 @@ void CanvasDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 			checkableAction->setDefaultWidget(checkBox);
 			linkedScenesMenu->addAction(checkableAction);
 
-			auto c = obs_data_get_array(settings, "canvas");
-			if (c) {
-				const auto count = obs_data_array_count(c);
-
-				for (size_t j = 0; j < count; j++) {
-					auto item = obs_data_array_item(c, j);
-					if (!item)
-						continue;
-					if (strcmp(obs_data_get_string(item, "name"), obs_canvas_get_name(canvas)) == 0) {
-						auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-						if (sn == sceneList->currentItem()->text()) {
-							checkBox->setChecked(true);
-						}
-					} else if (strcmp(obs_data_get_string(item, "name"), "") == 0 &&
-						   obs_data_get_int(item, "width") == canvas_width &&
-						   obs_data_get_int(item, "height") == canvas_height) {
-						obs_data_set_string(item, "name", obs_canvas_get_name(canvas));
-						auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-						if (sn == sceneList->currentItem()->text()) {
-							checkBox->setChecked(true);
-						}
-					}
-					obs_data_release(item);
-				}
-
-				obs_data_array_release(c);
+			if (!current.empty() && scene_links_get(src, canvas_name) == current) {
+				checkBox->setChecked(true);
 			}
-
-			obs_data_release(settings);
 		}
 		obs_frontend_source_list_free(&scenes);
 	});
@@ -3064,6 +3226,15 @@ void CanvasDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 	a->setCheckable(true);
 	obs_data_set_default_bool(private_settings, "show_in_multiview", true);
 	a->setChecked(obs_data_get_bool(private_settings, "show_in_multiview"));
+
+	a = menu.addAction(QString::fromUtf8(obs_module_text("PreloadScene")), [this, scene_name](bool checked) {
+		OBSSourceAutoRelease source = obs_canvas_get_source_by_name(canvas, scene_name.c_str());
+		OBSDataAutoRelease ps = obs_source_get_private_settings(source);
+		obs_data_set_bool(ps, "preload", checked);
+		UpdatePreload();
+	});
+	a->setCheckable(true);
+	a->setChecked(obs_data_get_bool(private_settings, "preload"));
 	menu.exec(QCursor::pos());
 }
 
@@ -3132,7 +3303,11 @@ void CanvasDock::SetLinkedScene(obs_source_t *scene_, const QString &linkedScene
 	obs_data_release(ss);
 	obs_data_release(found);
 	obs_data_array_release(c);
+	scene_links_reload(scene_);
 
+	if (!sceneList) {
+		return;
+	}
 	for (int row = 0; row < sceneList->count(); row++) {
 		auto item = sceneList->item(row);
 		item->setIcon(QIcon(":/aitum/media/unlinked.svg"));
@@ -3988,55 +4163,41 @@ void CanvasDock::LoadScenes()
 		}
 		obs_source_release(s);
 	}*/
-	if (sceneList) {
-		sceneList->clear();
-	}
-	if (sceneCombo) {
-		sceneCombo->clear();
-	}
-
 	obs_canvas_enum_scenes(
 		canvas,
 		[](void *param, obs_source_t *src) {
 			auto t = (CanvasDock *)param;
 
-			std::string ssn = obs_canvas_get_name(t->canvas);
-			ssn += " ";
-			ssn += obs_frontend_get_locale_string("Basic.Hotkeys.SelectScene");
-			obs_hotkey_register_source(
-				src, "OBSBasic.SelectScene", ssn.c_str(),
-				[](void *data, obs_hotkey_id, obs_hotkey_t *key, bool pressed) {
-					if (!pressed) {
-						return;
-					}
-					auto p = (CanvasDock *)data;
-					auto potential_source = (obs_weak_source_t *)obs_hotkey_get_registerer(key);
-					OBSSourceAutoRelease source = obs_weak_source_get_source(potential_source);
-					if (source) {
-						auto sn = QString::fromUtf8(obs_source_get_name(source));
-						QMetaObject::invokeMethod(p, "SwitchScene", Q_ARG(QString, sn), Q_ARG(bool, true));
-					}
-				},
-				t);
+			hotkey_dispatch_add_scene(t, src);
 			auto sh = obs_source_get_signal_handler(src);
 			signal_handler_connect(sh, "rename", source_rename, t);
 			signal_handler_connect(sh, "remove", source_remove, t);
+			return true;
+		},
+		this);
+
+	LoadSceneList();
+}
+
+void CanvasDock::LoadSceneList()
+{
+	sceneIndex.Clear();
+	if (sceneCombo) {
+		sceneCombo->clear();
+	}
+
+	obs_canvas_enum_scenes(
+		canvas,
+		[](void *param, obs_source_t *src) {
+			auto t = (CanvasDock *)param;
 			QString name = QString::fromUtf8(obs_source_get_name(src));
 			obs_data_t *settings = obs_source_get_settings(src);
 			if (t->sceneList) {
-				auto sli = new QListWidgetItem(name, t->sceneList);
+				auto sli = t->sceneIndex.Add(src);
 				sli->setIcon(QIcon(":/aitum/media/unlinked.svg"));
-				const int order = (int)obs_data_get_int(settings, "order");
-				t->sceneList->insertItem(order, sli);
 				if ((t->currentSceneName.isEmpty() && obs_data_get_bool(settings, "canvas_active")) ||
 				    name == t->currentSceneName) {
-					for (int j = 0; j < t->sceneList->count(); j++) {
-						auto item = t->sceneList->item(j);
-						if (item->text() != name) {
-							continue;
-						}
-						t->sceneList->setCurrentItem(item);
-					}
+					t->sceneList->setCurrentItem(sli);
 				}
 			}
 			if (t->sceneCombo) {
@@ -4061,7 +4222,8 @@ void CanvasDock::LoadScenes()
 			auto settings = obs_source_get_settings(scene);
 			const int order = (int)obs_data_get_int(settings, "order");
 			sceneList->insertItem(order, item);
-			if (obs_data_get_bool(settings, "canvas_active")) {
+			if (this->scene ? obs_scene_get_source(this->scene) == scene
+					: obs_data_get_bool(settings, "canvas_active")) {
 				selectedItem = item;
 			}
 			obs_data_release(settings);
@@ -4103,6 +4265,38 @@ void CanvasDock::LoadScenes()
 			sceneCombo->setCurrentIndex(0);
 		}
 	}
+	if (!sceneList && !sceneCombo) {
+		// no widgets yet, select the scene that was active when last saved or the first in order
+		struct active_scene {
+			std::string name;
+			int order = -1;
+			bool active = false;
+		} as;
+		obs_canvas_enum_scenes(
+			canvas,
+			[](void *param, obs_source_t *src) {
+				auto as = (active_scene *)param;
+				if (as->active) {
+					return true;
+				}
+				OBSDataAutoRelease ss = obs_source_get_settings(src);
+				const int order = (int)obs_data_get_int(ss, "order");
+				if (obs_data_get_bool(ss, "canvas_active") || as->order < 0 || order < as->order) {
+					as->name = obs_source_get_name(src);
+					as->order = order;
+					as->active = obs_data_get_bool(ss, "canvas_active");
+				}
+				return true;
+			},
+			&as);
+		if (as.name.empty()) {
+			AddScene("", false);
+		} else {
+			SwitchScene(QString::fromUtf8(as.name.c_str()), false);
+		}
+	}
+	PrepareTransitions();
+	UpdatePreload();
 }
 
 void CanvasDock::LoadTransitions()
@@ -4116,7 +4310,7 @@ void CanvasDock::LoadTransitions()
 		const char *name = obs_source_get_display_name(id);
 
 		OBSSourceAutoRelease tr = obs_source_create_private(id, name, NULL);
-		transitions.emplace_back(tr);
+		transitions.Add(tr);
 
 		//signals "transition_stop" and "transition_video_stop"
 		//        TransitionFullyStopped TransitionStopped
@@ -4132,7 +4326,7 @@ void CanvasDock::LoadTransitions()
 			}
 			OBSSourceAutoRelease transition = obs_load_private_source(td);
 			if (transition) {
-				transitions.emplace_back(transition);
+				transitions.Add(transition);
 			}
 
 			obs_data_release(td);
@@ -4158,44 +4352,61 @@ void CanvasDock::LoadTransitions()
 
 void CanvasDock::UpdateLinkedScenes()
 {
-	struct obs_frontend_source_list scenes = {};
-	obs_frontend_get_scenes(&scenes);
-	for (size_t i = 0; i < scenes.sources.num; i++) {
-		obs_source_t *src = scenes.sources.array[i];
-		obs_data_t *settings = obs_source_get_settings(src);
-		auto c = obs_data_get_array(settings, "canvas");
-		if (c) {
-			const auto count = obs_data_array_count(c);
-			for (size_t j = 0; j < count; j++) {
-				auto item = obs_data_array_item(c, j);
-				if (!item) {
-					continue;
-				}
-				if (strcmp(obs_data_get_string(item, "name"), obs_canvas_get_name(canvas)) == 0) {
-					auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-					auto sil = sceneList->findItems(sn, Qt::MatchExactly);
-					for (auto &si : sil) {
-						si->setIcon(QIcon(":/aitum/media/linked.svg"));
-					}
-				} else if (strcmp(obs_data_get_string(item, "name"), "") == 0 &&
-					   obs_data_get_int(item, "width") == canvas_width &&
-					   obs_data_get_int(item, "height") == canvas_height) {
-					obs_data_set_string(item, "name", obs_canvas_get_name(canvas));
-					auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-					auto sil = sceneList->findItems(sn, Qt::MatchExactly);
-					for (auto &si : sil) {
-						si->setIcon(QIcon(":/aitum/media/linked.svg"));
-					}
-				}
-				obs_data_release(item);
-			}
+	if (!sceneList) {
+		return;
+	}
+	const char *canvas_name = obs_canvas_get_name(canvas);
+	scene_links_adopt(canvas_name, canvas_width, canvas_height);
+	for (const auto &sn : scene_links_canvas_scenes(canvas_name)) {
+		auto si = sceneIndex.FindByName(QString::fromUtf8(sn.c_str()));
+		if (si) {
+			si->setIcon(QIcon(":/aitum/media/linked.svg"));
+		}
+	}
+}
 
-			obs_data_array_release(c);
+void CanvasDock::UpdatePreload()
+{
+	if (!canvas || ScenePreloader::MaxScenes() <= 0) {
+		preloader.Clear();
+		return;
+	}
+	QStringList names;
+	if (sceneList) {
+		for (int i = 0; i < sceneList->count(); i++) {
+			names.append(sceneList->item(i)->text());
+		}
+	} else if (sceneCombo) {
+		for (int i = 0; i < sceneCombo->count(); i++) {
+			names.append(sceneCombo->itemText(i));
 		}
+	}
+	const auto current = names.indexOf(currentSceneName);
 
-		obs_data_release(settings);
+	// the next scene in the list is the most likely cut, then the scenes marked to preload, then the previous one
+	std::vector<obs_source_t *> candidates;
+	if (current >= 0 && current + 1 < names.count()) {
+		candidates.push_back(obs_canvas_get_source_by_name(canvas, names[current + 1].toUtf8().constData()));
+	}
+	for (int i = 0; i < names.count(); i++) {
+		if (i == current) {
+			continue;
+		}
+		auto s = obs_canvas_get_source_by_name(canvas, names[i].toUtf8().constData());
+		OBSDataAutoRelease ps = s ? obs_source_get_private_settings(s) : nullptr;
+		if (obs_data_get_bool(ps, "preload")) {
+			candidates.push_back(s);
+		} else {
+			obs_source_release(s);
+		}
+	}
+	if (current > 0) {
+		candidates.push_back(obs_canvas_get_source_by_name(canvas, names[current - 1].toUtf8().constData()));
+	}
+	preloader.Update(candidates);
+	for (auto s : candidates) {
+		obs_source_release(s);
 	}
-	obs_frontend_source_list_free(&scenes);
 }
 
 void CanvasDock::source_rename(void *data, calldata_t *calldata)
@@ -4208,44 +4419,21 @@ void CanvasDock::source_rename(void *data, calldata_t *calldata)
 		return;
 	}
 
-	struct obs_frontend_source_list scenes = {};
-	obs_frontend_get_scenes(&scenes);
-	for (size_t i = 0; i < scenes.sources.num; i++) {
-		const obs_source_t *src = scenes.sources.array[i];
-		auto ss = obs_source_get_settings(src);
-		auto c = obs_data_get_array(ss, "canvas");
-		obs_data_release(ss);
-		if (!c) {
-			continue;
-		}
-		const auto count = obs_data_array_count(c);
-		for (size_t j = 0; j < count; j++) {
-			auto item = obs_data_array_item(c, j);
-			auto n = QString::fromUtf8(obs_data_get_string(item, "scene"));
-			if (n == prev_name) {
-				obs_data_set_string(item, "scene", calldata_string(calldata, "new_name"));
-			}
-			obs_data_release(item);
-		}
-		obs_data_array_release(c);
-	}
-	obs_frontend_source_list_free(&scenes);
+	const char *canvas_name = obs_canvas_get_name(d->canvas);
+	scene_links_adopt(canvas_name, d->canvas_width, d->canvas_height);
+	scene_links_rename_canvas_scene(canvas_name, calldata_string(calldata, "prev_name"), calldata_string(calldata, "new_name"));
 
-	if (d->sceneList) {
-		for (int i = 0; i < d->sceneList->count(); i++) {
-			const auto item = d->sceneList->item(i);
-			if (item->text() != prev_name) {
-				continue;
+	const auto uuid = QString::fromUtf8(obs_source_get_uuid(source));
+	QMetaObject::invokeMethod(d, [d, uuid, prev_name, new_name] {
+		auto item = d->sceneIndex.FindByUuid(uuid);
+		d->sceneIndex.Rename(item ? item : d->sceneIndex.FindByName(prev_name), new_name);
+		if (d->sceneCombo) {
+			const auto index = d->sceneCombo->findText(prev_name);
+			if (index >= 0) {
+				d->sceneCombo->setItemText(index, new_name);
 			}
-			item->setText(new_name);
 		}
-	}
-	if (d->sceneCombo) {
-		const auto index = d->sceneCombo->findText(prev_name);
-		if (index >= 0) {
-			d->sceneCombo->setItemText(index, new_name);
-		}
-	}
+	});
 }
 
 void CanvasDock::source_add(void *data, calldata_t *calldata)
@@ -4273,36 +4461,21 @@ void CanvasDock::SceneAdded(const QString sn)
 	if (!scene) {
 		return;
 	}
-	std::string ssn = obs_canvas_get_name(canvas);
-	ssn += " ";
-	ssn += obs_frontend_get_locale_string("Basic.Hotkeys.SelectScene");
-	obs_hotkey_register_source(
-		scene, "OBSBasic.SelectScene", ssn.c_str(),
-		[](void *data, obs_hotkey_id, obs_hotkey_t *key, bool pressed) {
-			if (!pressed) {
-				return;
-			}
-			auto p = (CanvasDock *)data;
-			auto potential_source = (obs_weak_source_t *)obs_hotkey_get_registerer(key);
-			OBSSourceAutoRelease source = obs_weak_source_get_source(potential_source);
-			if (source) {
-				auto sn = QString::fromUtf8(obs_source_get_name(source));
-				QMetaObject::invokeMethod(p, "SwitchScene", Q_ARG(QString, sn), Q_ARG(bool, true));
-			}
-		},
-		this);
+	hotkey_dispatch_add_scene(this, scene);
 	auto sh = obs_source_get_signal_handler(scene);
 	signal_handler_connect(sh, "rename", source_rename, this);
 	signal_handler_connect(sh, "remove", source_remove, this);
 
-	if (sceneList) {
-		auto sli = new QListWidgetItem(sn, sceneList);
+	if (sceneList && !sceneIndex.Find(scene)) {
+		auto sli = sceneIndex.Add(scene);
 		sli->setIcon(QIcon(":/aitum/media/unlinked.svg"));
-		sceneList->addItem(sli);
 	}
 	if (sceneCombo) {
 		sceneCombo->addItem(sn);
 	}
+	obs_source_release(scene);
+	PrepareTransitions();
+	UpdatePreload();
 }
 
 void CanvasDock::source_remove(void *data, calldata_t *calldata)
@@ -4317,6 +4490,7 @@ void CanvasDock::source_remove(void *data, calldata_t *calldata)
 	if (!canvas || canvas != d->canvas) {
 		return;
 	}
+	hotkey_dispatch_remove_scene(source);
 	if (obs_weak_source_references_source(d->source, source) || source == obs_scene_get_source(d->scene)) {
 		QMetaObject::invokeMethod(d, "SwitchScene", Q_ARG(QString, ""), Q_ARG(bool, false));
 	}
@@ -4330,13 +4504,7 @@ void CanvasDock::source_remove(void *data, calldata_t *calldata)
 void CanvasDock::SceneRemoved(const QString name)
 {
 	if (sceneList) {
-		for (int i = 0; i < sceneList->count(); i++) {
-			auto item = sceneList->item(i);
-			if (item->text() != name) {
-				continue;
-			}
-			sceneList->takeItem(i);
-		}
+		sceneIndex.Remove(sceneIndex.FindByName(name));
 		auto r = sceneList->currentRow();
 		auto c = sceneList->count();
 		if ((r < 0 && c > 0) || r >= c) {
@@ -4352,13 +4520,14 @@ void CanvasDock::SceneRemoved(const QString name)
 			sceneCombo->setCurrentIndex(0);
 		}
 	}
+	UpdatePreload();
 }
 
 void CanvasDock::AddSceneItem(OBSSceneItem item, bool no_select)
 {
 	obs_scene_t *add_scene = obs_sceneitem_get_scene(item);
 
-	if (scene == add_scene) {
+	if (scene == add_scene && sourceList) {
 		sourceList->Add(item);
 	}
 
@@ -4384,7 +4553,7 @@ bool CanvasDock::select_one(obs_scene_t *scene, obs_sceneitem_t *item, void *par
 
 void CanvasDock::RefreshSources(OBSScene refresh_scene)
 {
-	if (refresh_scene != scene || sourceList->IgnoreReorder()) {
+	if (refresh_scene != scene || !sourceList || sourceList->IgnoreReorder()) {
 		return;
 	}
 
@@ -4393,7 +4562,7 @@ void CanvasDock::RefreshSources(OBSScene refresh_scene)
 
 void CanvasDock::ReorderSources(OBSScene order_scene)
 {
-	if (order_scene != scene || sourceList->IgnoreReorder()) {
+	if (order_scene != scene || !sourceList || sourceList->IgnoreReorder()) {
 		return;
 	}
 
@@ -4402,6 +4571,11 @@ void CanvasDock::ReorderSources(OBSScene order_scene)
 
 void CanvasDock::SwitchBackToSelectedTransition()
 {
+	// disconnect here too, nothing is swapped when the override has become the selected transition
+	OBSSourceAutoRelease current = obs_weak_source_get_source(source);
+	if (current)
+		signal_handler_disconnect(obs_source_get_signal_handler(current), "transition_stop", transition_override_stop,
+					  this);
 	auto tn = transition->currentText().toUtf8();
 	auto transition = GetTransition(tn.constData());
 	SwapTransition(transition);
@@ -4412,6 +4586,11 @@ OBSEventFilter *CanvasDock::BuildEventFilter()
 	return new OBSEventFilter([this](QObject *obj, QEvent *event) {
 		UNUSED_PARAMETER(obj);
 
+		if (event->type() == QEvent::Enter) {
+			previewThrottle.SetHovered(true);
+		} else if (event->type() == QEvent::Leave) {
+			previewThrottle.SetHovered(false);
+		}
 		if (!scene) {
 			return false;
 		}
@@ -4613,10 +4792,18 @@ bool CanvasDock::HandleMouseReleaseEvent(QMouseEvent *event)
 		QAction *a =
 			popup.addAction(QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.Preview.Disable")), [this] {
 				preview_disabled = !preview_disabled;
-				obs_display_set_enabled(preview->GetDisplay(), !preview_disabled);
-				preview->setVisible(!preview_disabled);
-				previewDisabledWidget->setVisible(preview_disabled);
+				UpdatePreviewEnabled();
 			});
+		auto rateMenu = popup.addMenu(QString::fromUtf8(obs_module_text("PreviewRate")));
+		auto addRate = [this, rateMenu](const char *text, PreviewPolicy policy) {
+			auto action = rateMenu->addAction(QString::fromUtf8(obs_module_text(text)),
+							  [this, policy] { SetPreviewPolicy(policy); });
+			action->setCheckable(true);
+			action->setChecked(previewThrottle.GetPolicy() == policy);
+		};
+		addRate("PreviewRateFull", PreviewPolicy::Full);
+		addRate("PreviewRateReduced", PreviewPolicy::Reduced);
+		addRate("PreviewRateHover", PreviewPolicy::Hover);
 		auto projectorMenu = popup.addMenu(QString::fromUtf8(obs_frontend_get_locale_string("Projector.Open.Preview")));
 		AddProjectorMenuMonitors(projectorMenu, this, "OpenPreviewProjector");
 
@@ -5930,48 +6117,16 @@ void CanvasDock::MainSceneChanged()
 {
 	auto current_scene = obs_frontend_get_current_scene();
 	if (!current_scene) {
-		//if (linkedButton)
-		//	linkedButton->setChecked(false);
 		return;
 	}
-
-	auto ss = obs_source_get_settings(current_scene);
+	const char *canvas_name = obs_canvas_get_name(canvas);
+	scene_links_adopt(canvas_name, canvas_width, canvas_height);
+	auto sn = scene_links_get(current_scene, canvas_name);
 	obs_source_release(current_scene);
-	auto c = obs_data_get_array(ss, "canvas");
-	obs_data_release(ss);
-	if (!c) {
-		//if (linkedButton)
-		//	linkedButton->setChecked(false);
-		return;
+	if (!sn.empty()) {
+		switch_latency_request(canvas, "linked");
+		SwitchScene(QString::fromUtf8(sn.c_str()));
 	}
-	const auto count = obs_data_array_count(c);
-	obs_data_t *found = nullptr;
-	for (size_t i = 0; i < count; i++) {
-		auto item = obs_data_array_item(c, i);
-		if (!item) {
-			continue;
-		}
-		if (strcmp(obs_data_get_string(item, "name"), obs_canvas_get_name(canvas)) == 0) {
-			found = item;
-			break;
-		} else if (strcmp(obs_data_get_string(item, "name"), "") == 0 && obs_data_get_int(item, "width") == canvas_width &&
-			   obs_data_get_int(item, "height") == canvas_height) {
-			obs_data_set_string(item, "name", obs_canvas_get_name(canvas));
-			found = item;
-			break;
-		}
-		obs_data_release(item);
-	}
-	if (found) {
-		auto sn = QString::fromUtf8(obs_data_get_string(found, "scene"));
-		SwitchScene(sn);
-		//if (linkedButton)
-		//	linkedButton->setChecked(true);
-	} // else if (linkedButton) {
-	//	linkedButton->setChecked(false);
-	//}
-	obs_data_release(found);
-	obs_data_array_release(c);
 }
 
 void CanvasDock::save_load(obs_data_t *save_data, bool saving, void *param)
@@ -5993,6 +6148,18 @@ void CanvasDock::save_load(obs_data_t *save_data, bool saving, void *param)
 				}
 			}
 		}
+		if (!window->sceneList && !window->sceneCombo && window->settings) {
+			obs_canvas_enum_scenes(
+				window->canvas,
+				[](void *param, obs_source_t *scene) {
+					auto w = (CanvasDock *)param;
+					OBSDataAutoRelease settings = obs_source_get_settings(scene);
+					obs_data_set_bool(settings, "canvas_active",
+							  QString::fromUtf8(obs_source_get_name(scene)) == w->currentSceneName);
+					return true;
+				},
+				window);
+		}
 		if (window->sceneCombo) {
 			auto c = window->sceneCombo->count();
 			for (int row = 0; row < c; row++) {
@@ -6175,6 +6342,7 @@ void CanvasDock::UpdateSettings(obs_data_t *s)
 
 void CanvasDock::reset_live_state()
 {
+	LoadUI();
 	if (panel_split) {
 		panel_split->restorePanelOrder("scenesGroup,sourcesGroup,transitionsGroup");
 		panel_split->setSizes({1, 0, 0});
@@ -6185,6 +6353,7 @@ void CanvasDock::reset_live_state()
 
 void CanvasDock::reset_build_state()
 {
+	LoadUI();
 	canvas_split->restorePanelOrder(panel_split ? "panelSplit,canvasPreview" : "sourcesGroup,canvasPreview");
 	if (panel_split) {
 		panel_split->restorePanelOrder("scenesGroup,sourcesGroup,transitionsGroup");
@@ -6218,6 +6387,16 @@ void CanvasDock::LogScenes()
 			obs_source_enum_filters(obs_scene_get_source(scene), LogFilter, (void *)(intptr_t)1);
 			obs_scene_release(scene);
 		}
+	} else {
+		obs_canvas_enum_scenes(
+			canvas,
+			[](void *, obs_source_t *src) {
+				blog(LOG_INFO, "- scene '%s':", obs_source_get_name(src));
+				obs_scene_enum_items(obs_scene_from_source(src), LogSceneItem, (void *)(intptr_t)1);
+				obs_source_enum_filters(src, LogFilter, (void *)(intptr_t)1);
+				return true;
+			},
+			nullptr);
 	}
 	blog(LOG_INFO, "------------------------------------------------");
 }
@@ -6441,6 +6620,7 @@ void CanvasDock::Nudge(int dist, MoveDir dir)
 
 void CanvasDock::SetPanelVisible(const QString &panel_name, bool visible)
 {
+	LoadUI();
 	if (panel_name == "canvas") {
 		auto canvas_sizes = canvas_split->sizes();
 		if (canvas_sizes[0] == 0 && visible) {
@@ -6493,6 +6673,30 @@ void CanvasDock::SetPanelVisible(const QString &panel_name, bool visible)
 	}
 }
 
+PreviewPolicy CanvasDock::GetPreviewPolicy() const
+{
+	return preview_disabled ? PreviewPolicy::Disabled : previewThrottle.GetPolicy();
+}
+
+void CanvasDock::SetPreviewPolicy(PreviewPolicy policy)
+{
+	preview_disabled = policy == PreviewPolicy::Disabled;
+	if (!preview_disabled) {
+		previewThrottle.SetPolicy(policy);
+	}
+	UpdatePreviewEnabled();
+}
+
+void CanvasDock::UpdatePreviewEnabled()
+{
+	if (!preview) {
+		return;
+	}
+	obs_display_set_enabled(preview->GetDisplay(), !preview_disabled && !previewOccluded);
+	preview->setVisible(!preview_disabled);
+	previewDisabledWidget->setVisible(preview_disabled);
+}
+
 void CanvasDock::SetSelectedTransition(const QString &transition_name)
 {
 	auto pos = transition->findText(transition_name);
@@ -6509,15 +6713,13 @@ void CanvasDock::AddTransition(const char *source_type, const char *name, obs_da
 	if (!name || name[0] == '\0') {
 		return;
 	}
-	for (auto tr : transitions) {
-		if (strcmp(obs_source_get_name(tr), name) == 0) {
-			return;
-		}
+	if (transitions.Find(name)) {
+		return;
 	}
 
 	OBSSourceAutoRelease source = obs_source_create(source_type, name, settings, nullptr);
 	if (source) {
-		transitions.emplace_back(source);
+		transitions.Add(source);
 		auto n = QString::fromUtf8(name);
 		QMetaObject::invokeMethod(this, [this, n]() { transition->addItem(n); });
 	}
@@ -6525,14 +6727,12 @@ void CanvasDock::AddTransition(const char *source_type, const char *name, obs_da
 
 void CanvasDock::RemoveTransition(const char *transition_name)
 {
-	for (auto it = transitions.begin(); it != transitions.end(); ++it) {
-		if (strcmp(transition_name, obs_source_get_name(it->Get())) == 0) {
-			if (!obs_is_source_configurable(obs_source_get_id(it->Get()))) {
-				return;
-			}
-			transitions.erase(it);
-			break;
+	auto t = transitions.Find(transition_name);
+	if (t) {
+		if (!obs_is_source_configurable(obs_source_get_id(t))) {
+			return;
 		}
+		transitions.Remove(t);
 	}
 	auto name = QString::fromUtf8(transition_name);
 	QMetaObject::invokeMethod(this, [this, name]() {
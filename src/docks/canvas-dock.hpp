@@ -1,12 +1,17 @@
 
 #pragma once
 #include "../utils/event-filter.hpp"
+#include "../utils/preview-throttle.hpp"
+#include "../utils/scene-index.hpp"
+#include "../utils/scene-preload.hpp"
+#include "../utils/transition-pool.hpp"
 #include "../utils/widgets/projector.hpp"
 #include "../utils/widgets/qt-display.hpp"
 #include "../utils/widgets/source-tree.hpp"
 #include "../utils/widgets/switching-splitter.hpp"
 #include <graphics/matrix4.h>
 #include <graphics/vec2.h>
+#include <map>
 #include <mutex>
 #include <obs.h>
 #include <QComboBox>
@@ -18,6 +23,7 @@
 #include <QSplitter>
 #include <QWheelEvent>
 #include <util/config-file.h>
+#include <vector>
 
 #define ITEM_LEFT (1 << 0)
 #define ITEM_RIGHT (1 << 1)
@@ -40,6 +46,7 @@ enum class ItemHandle : uint32_t {
 
 #define HANDLE_RADIUS 4.0f
 #define HANDLE_SEL_RADIUS (HANDLE_RADIUS * 1.5f)
+#define SPACER_LABEL_CACHE_SIZE 64
 
 class OBSProjector;
 
@@ -54,14 +61,27 @@ private:
 	std::string canvas_name;
 	SwitchingSplitter *canvas_split = nullptr;
 	SwitchingSplitter *panel_split = nullptr;
-	OBSQTDisplay *preview;
+	OBSQTDisplay *preview = nullptr;
 	obs_data_t *settings = nullptr;
 
 	OBSSourceAutoRelease spacerLabel[4];
 	int spacerPx[4] = {0};
+	uint64_t spacerPxFrame[4] = {0};
+	std::string spacerLabelKey[4];
+	struct SpacerLabelTexture {
+		gs_texrender_t *texrender = nullptr;
+		uint32_t cx = 0;
+		uint32_t cy = 0;
+		uint64_t used = 0;
+	};
+	std::map<std::string, SpacerLabelTexture> spacerLabelCache;
+	uint64_t spacerLabelUse = 0;
 	gs_vertbuffer_t *box = nullptr;
-	gs_vertbuffer_t *rectFill = nullptr;
-	gs_vertbuffer_t *circleFill = nullptr;
+	gs_vertbuffer_t *overlayBuffer = nullptr;
+	size_t overlayCapacity = 0;
+	std::vector<vec3> overlayPoints;
+	std::vector<uint32_t> overlayColors;
+	uint32_t overlayColor = 0xFFFFFFFF;
 
 	obs_scene_t *scene = nullptr;
 	//obs_view_t *view = nullptr;
@@ -89,11 +109,13 @@ private:
 
 	SourceTree *sourceList = nullptr;
 	QListWidget *sceneList = nullptr;
+	SceneIndex sceneIndex;
+	ScenePreloader preloader;
 	QComboBox *sceneCombo = nullptr;
 	bool hideScenes = true;
 	QString currentSceneName;
 	OBSWeakSource source;
-	std::vector<OBSSource> transitions;
+	TransitionPool transitions;
 	QComboBox *transition = nullptr;
 	std::vector<OBSProjector *> projectors;
 
@@ -104,7 +126,9 @@ private:
 	bool cropping = false;
 	bool mouseOverItems = false;
 	bool preview_disabled = false;
+	bool previewOccluded = false;
 	QFrame *previewDisabledWidget;
+	PreviewThrottle previewThrottle;
 	vec2 scrollingFrom{};
 	vec2 scrollingOffset{};
 	vec2 lastMoveOffset{};
@@ -129,6 +153,7 @@ private:
 	OBSEventFilter *BuildEventFilter();
 	void LoadUI();
 	void LoadProjectors(obs_data_array_t *pa);
+	void UpdatePreviewEnabled();
 	bool HandleMousePressEvent(QMouseEvent *event);
 	bool HandleMouseReleaseEvent(QMouseEvent *event);
 	bool HandleMouseMoveEvent(QMouseEvent *event);
@@ -161,9 +186,10 @@ private:
 	void DrawBackdrop(float cx, float cy);
 	void DrawSpacingHelpers(obs_scene_t *scene, float x, float y, float cx, float cy, float scale, float sourceX,
 				float sourceY);
-	bool DrawSelectionBox(float x1, float y1, float x2, float y2, gs_vertbuffer_t *rectFill);
+	bool DrawSelectionBox(float x1, float y1, float x2, float y2);
 	void DrawSpacingLine(vec3 &start, vec3 &end, vec3 &viewport, float pixelRatio);
 	void SetLabelText(int sourceIndex, int px);
+	SpacerLabelTexture *GetSpacerLabelTexture(int sourceIndex, int px);
 	void RenderSpacingHelper(int sourceIndex, vec3 &start, vec3 &end, vec3 &viewport, float pixelRatio);
 	float GetDevicePixelRatio();
 
@@ -172,6 +198,7 @@ private:
 	void ChangeSceneIndex(bool relative, int offset, int invalidIdx);
 	QListWidget *GetGlobalScenesList();
 	void LoadScenes();
+	void LoadSceneList();
 	void LoadTransitions();
 	void UpdateLinkedScenes();
 	void AddScene(QString duplicate = "", bool ask_name = true);
@@ -209,12 +236,16 @@ private:
 	static bool FindSelected(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
 	static void DrawPreview(void *data, uint32_t cx, uint32_t cy);
 	static bool DrawSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
-	static void DrawLabel(OBSSource source, vec3 &pos, vec3 &viewport);
-	static void DrawLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale);
-	static void DrawStripedLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale);
-	static void DrawRect(float thickness, vec2 scale);
-	static void DrawSquareAtPos(float x, float y, float pixelRatio);
-	static void DrawRotationHandle(gs_vertbuffer_t *circle, float rot, float pixelRatio);
+	static void DrawLabel(const SpacerLabelTexture *label, vec3 &pos, vec3 &viewport);
+	void AddOverlayTriangle(const vec3 &a, const vec3 &b, const vec3 &c);
+	void AddOverlayQuad(float x, float y, float axisX, float axisY, float sideX, float sideY);
+	void AddOverlayCircle();
+	void DrawOverlay();
+	void DrawLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale);
+	void DrawStripedLine(float x1, float y1, float x2, float y2, float thickness, vec2 scale);
+	void DrawRect(float thickness, vec2 scale);
+	void DrawSquareAtPos(float x, float y, float pixelRatio);
+	void DrawRotationHandle(float rot, float pixelRatio);
 	static void GetScaleAndCenterPos(int baseCX, int baseCY, int windowCX, int windowCY, int &x, int &y, float &scale);
 	static vec2 GetItemSize(obs_sceneitem_t *item);
 	static vec3 GetTransformedPos(float x, float y, const matrix4 &mat);
@@ -225,6 +256,9 @@ private:
 	static inline bool crop_enabled(const obs_sceneitem_crop *crop);
 
 	static void SceneItemAdded(void *data, calldata_t *params);
+	static void SceneItemRemoved(void *data, calldata_t *params);
+	static void SceneItemVisible(void *data, calldata_t *params);
+	static void SceneItemLocked(void *data, calldata_t *params);
 	static void SceneReordered(void *data, calldata_t *params);
 	static void SceneRefreshed(void *data, calldata_t *params);
 	static void transition_override_stop(void *data, calldata_t *);
@@ -277,12 +311,16 @@ private slots:
 	void OpenPreviewProjector();
 	void OpenSourceProjector();
 
+protected:
+	void showEvent(QShowEvent *event) override;
+
 public:
 	CanvasDock(obs_data_t *settings, QWidget *parent = nullptr);
 	CanvasDock(const char *canvas_name, QWidget *parent = nullptr);
 	~CanvasDock();
 
 	obs_canvas_t *GetCanvas() const { return canvas; }
+	void SwitchToScene(obs_source_t *s, bool transition = true);
 	void UpdateSettings(obs_data_t *settings);
 
 	uint32_t GetCanvasWidth() { return canvas_width; };
@@ -292,6 +330,10 @@ public:
 	void reset_build_state();
 
 	void SetPanelVisible(const QString &panel_name, bool visible);
+	PreviewPolicy GetPreviewPolicy() const;
+	void SetPreviewPolicy(PreviewPolicy policy);
+	void UpdatePreload();
+	void PrepareTransitions();
 	QList<obs_source_t *> GetTransitions() const
 	{
 		QList<obs_source_t *> transitionList;
@@ -8,6 +8,7 @@
 #include <QVBoxLayout>
 #include <src/dialogs/name-dialog.hpp>
 #include <src/utils/widgets/visibility-item-widget.hpp>
+#include <unordered_set>
 
 extern PropertiesDock *properties_dock;
 
@@ -375,7 +376,7 @@ void FiltersDock::SourceChanged(OBSSource s)
 
 		obs_weak_source_release(source);
 	}
-	filtersList->clear();
+	ClearFilterItems();
 	if (!s) {
 		source = nullptr;
 		return;
@@ -387,18 +388,47 @@ void FiltersDock::SourceChanged(OBSSource s)
 	signal_handler_connect(obs_source_get_signal_handler(s), "filter_remove", filter_remove, this);
 	signal_handler_connect(obs_source_get_signal_handler(s), "reorder_filters", filter_reorder, this);
 
+	filtersList->setUpdatesEnabled(false);
 	obs_source_enum_filters(
 		s,
 		[](obs_source_t *parent, obs_source_t *filter, void *param) {
 			UNUSED_PARAMETER(parent);
-			auto this_ = static_cast<FiltersDock *>(param);
-			auto item = new QListWidgetItem();
-			OBSSource f = filter;
-			item->setData(Qt::UserRole, QVariant::fromValue(f));
-			this_->filtersList->addItem(item);
-			this_->filtersList->setItemWidget(item, new VisibilityItemWidget(filter));
+			static_cast<FiltersDock *>(param)->AddFilterItem(filter);
 		},
 		this);
+	filtersList->setUpdatesEnabled(true);
+}
+
+QListWidgetItem *FiltersDock::AddFilterItem(obs_source_t *filter, int row)
+{
+	auto it = filterItems.find(filter);
+	if (it != filterItems.end())
+		return it->second;
+	auto item = new QListWidgetItem();
+	OBSSource f = filter;
+	item->setData(Qt::UserRole, QVariant::fromValue(f));
+	if (row < 0)
+		filtersList->addItem(item);
+	else
+		filtersList->insertItem(row, item);
+	filtersList->setItemWidget(item, new VisibilityItemWidget(filter));
+	filterItems.emplace(filter, item);
+	return item;
+}
+
+void FiltersDock::RemoveFilterItem(obs_source_t *filter)
+{
+	auto it = filterItems.find(filter);
+	if (it == filterItems.end())
+		return;
+	delete filtersList->takeItem(filtersList->row(it->second));
+	filterItems.erase(it);
+}
+
+void FiltersDock::ClearFilterItems()
+{
+	filterItems.clear();
+	filtersList->clear();
 }
 
 void FiltersDock::SourceDeselected(OBSSource s)
@@ -415,10 +445,9 @@ void FiltersDock::filter_add(void *param, calldata_t *cd)
 
 	OBSSource f = filter;
 	QMetaObject::invokeMethod(this_, [this_, f] {
-		auto item = new QListWidgetItem();
-		item->setData(Qt::UserRole, QVariant::fromValue(f));
-		this_->filtersList->addItem(item);
-		this_->filtersList->setItemWidget(item, new VisibilityItemWidget(f));
+		if (!obs_weak_source_references_source(this_->source, obs_filter_get_parent(f)))
+			return;
+		this_->AddFilterItem(f);
 	});
 }
 
@@ -428,18 +457,7 @@ void FiltersDock::filter_remove(void *param, calldata_t *cd)
 	auto this_ = static_cast<FiltersDock *>(param);
 	auto filter = (obs_source_t *)calldata_ptr(cd, "filter");
 	OBSSource f = filter;
-	QMetaObject::invokeMethod(this_, [this_, f] {
-		for (int i = 0; i < this_->filtersList->count(); i++) {
-			auto item = this_->filtersList->item(i);
-			if (!item)
-				continue;
-			auto filter_ = item->data(Qt::UserRole).value<OBSSource>();
-			if (filter_ != f)
-				continue;
-			delete this_->filtersList->takeItem(i);
-			break;
-		}
-	});
+	QMetaObject::invokeMethod(this_, [this_, f] { this_->RemoveFilterItem(f); });
 }
 
 void FiltersDock::filter_reorder(void *param, calldata_t *cd)
@@ -453,38 +471,47 @@ void FiltersDock::filter_reorder(void *param, calldata_t *cd)
 
 void FiltersDock::Reorder()
 {
-	const auto item = filtersList->currentItem();
-	QString currentItem;
-	if (item)
-		currentItem = item->text();
-	filtersList->clear();
-
 	obs_source_t *s = obs_weak_source_get_source(source);
 	if (!s)
 		return;
+	std::vector<obs_source_t *> filters;
 	obs_source_enum_filters(
 		s,
 		[](obs_source_t *parent, obs_source_t *filter, void *param) {
 			UNUSED_PARAMETER(parent);
-			auto this_ = static_cast<FiltersDock *>(param);
-			auto item = new QListWidgetItem();
-			OBSSource f = filter;
-			item->setData(Qt::UserRole, QVariant::fromValue(f));
-			this_->filtersList->addItem(item);
-			this_->filtersList->setItemWidget(item, new VisibilityItemWidget(filter));
+			static_cast<std::vector<obs_source_t *> *>(param)->push_back(filter);
 		},
-		this);
-	obs_source_release(s);
+		&filters);
 
-	if (!currentItem.isEmpty()) {
-		for (int i = 0; i < filtersList->count(); i++) {
-			auto item = filtersList->item(i);
-			if (item && item->text() == currentItem) {
-				filtersList->setCurrentItem(item);
-				item->setSelected(true);
-			}
+	std::unordered_set<obs_source_t *> present(filters.begin(), filters.end());
+	for (auto it = filterItems.begin(); it != filterItems.end();) {
+		if (present.count(it->first)) {
+			++it;
+			continue;
 		}
+		delete filtersList->takeItem(filtersList->row(it->second));
+		it = filterItems.erase(it);
 	}
+
+	// rows before i are already in place, so each misplaced filter moves up once and keeps its widget and selection
+	auto model = filtersList->model();
+	for (int i = 0; i < (int)filters.size(); i++) {
+		auto it = filterItems.find(filters[i]);
+		if (it == filterItems.end()) {
+			AddFilterItem(filters[i], i);
+			continue;
+		}
+		auto row = filtersList->row(it->second);
+		if (row == i || model->moveRow(QModelIndex(), row, QModelIndex(), i))
+			continue;
+		bool current = filtersList->currentItem() == it->second;
+		delete filtersList->takeItem(row);
+		filterItems.erase(it);
+		auto item = AddFilterItem(filters[i], i);
+		if (current)
+			filtersList->setCurrentItem(item);
+	}
+	obs_source_release(s);
 }
 
 void FiltersDock::source_remove(void *param, calldata_t *cd)
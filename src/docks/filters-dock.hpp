@@ -6,13 +6,18 @@
 #include <QMenu>
 #include <obs.h>
 #include <obs.hpp>
+#include <unordered_map>
 
 class FiltersDock : public QFrame {
 	Q_OBJECT
 private:
 	QListWidget *filtersList = nullptr;
 	obs_weak_source_t *source = nullptr;
+	std::unordered_map<obs_source_t *, QListWidgetItem *> filterItems;
 
+	QListWidgetItem *AddFilterItem(obs_source_t *filter, int row = -1);
+	void RemoveFilterItem(obs_source_t *filter);
+	void ClearFilterItems();
 	void AddFilterMenu(QMenu *addFilterMEnu);
 	void ChangeFilterIndex(QListWidgetItem *widget_item, enum obs_order_movement movement);
 	void ShowFiltersContextMenu(QListWidgetItem *widget_item);
@@ -5,6 +5,14 @@
 #include <QMenu>
 #include <obs-frontend-api.h>
 
+static obs_source_t *live_scene_source(QListWidgetItem *item)
+{
+	auto scene = obs_get_source_by_uuid(item->data(Qt::UserRole).toString().toUtf8().constData());
+	if (!scene)
+		scene = obs_get_source_by_name(item->text().toUtf8().constData());
+	return scene;
+}
+
 LiveScenesDock::LiveScenesDock(QWidget *parent) : QFrame(parent)
 {
 	setMinimumWidth(100);
@@ -13,6 +21,7 @@ LiveScenesDock::LiveScenesDock(QWidget *parent) : QFrame(parent)
 	auto mainLayout = new QVBoxLayout(this);
 	mainLayout->setContentsMargins(0, 0, 0, 0);
 	sceneList = new QListWidget();
+	sceneIndex.Bind(sceneList);
 	sceneList->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
 	sceneList->setFrameShape(QFrame::NoFrame);
 	sceneList->setFrameShadow(QFrame::Plain);
@@ -22,9 +31,7 @@ LiveScenesDock::LiveScenesDock(QWidget *parent) : QFrame(parent)
 		const auto item = sceneList->currentItem();
 		if (!item)
 			return;
-		auto scene = obs_get_source_by_uuid(item->data(Qt::UserRole).toString().toUtf8().constData());
-		if (!scene)
-			scene = obs_get_source_by_name(item->text().toUtf8().constData());
+		auto scene = live_scene_source(item);
 		if (scene) {
 			auto current_scene = obs_frontend_get_current_scene();
 			if (scene != current_scene)
@@ -58,14 +65,7 @@ LiveScenesDock::LiveScenesDock(QWidget *parent) : QFrame(parent)
 			while (name && *name) {
 				auto n = *name;
 				menu.addAction(QString::fromUtf8(n), [this, n] {
-					auto scene = obs_get_source_by_name(n);
-					if (!scene)
-						return;
-
-					auto sli = new QListWidgetItem(QString::fromUtf8(obs_source_get_name(scene)), sceneList);
-					sli->setData(Qt::UserRole, QString::fromUtf8(obs_source_get_uuid(scene)));
-					sceneList->addItem(sli);
-					obs_source_release(scene);
+					AddLiveScene(QString::fromUtf8(n));
 				});
 
 				name++;
@@ -81,7 +81,8 @@ LiveScenesDock::LiveScenesDock(QWidget *parent) : QFrame(parent)
 				       auto row = sceneList->currentRow();
 				       if (row < 0)
 					       return;
-				       sceneList->takeItem(row);
+				       sceneIndex.Remove(sceneList->item(row));
+				       UpdatePreload();
 			       });
 	toolbar->widgetForAction(a)->setProperty("themeID", QVariant(QString::fromUtf8("removeIconSmall")));
 	toolbar->widgetForAction(a)->setProperty("class", "icon-minus");
@@ -127,7 +128,7 @@ void LiveScenesDock::save_load(obs_data_t *save_data, bool saving, void *private
 		obs_data_set_array(save_data, "live_scenes", ls);
 		obs_data_array_release(ls);
 	} else {
-		lsd->sceneList->clear();
+		lsd->sceneIndex.Clear();
 		auto ls = obs_data_get_array(save_data, "live_scenes");
 		if (ls) {
 			auto count = obs_data_array_count(ls);
@@ -135,14 +136,13 @@ void LiveScenesDock::save_load(obs_data_t *save_data, bool saving, void *private
 				auto item = obs_data_array_item(ls, idx);
 				if (!item)
 					continue;
-				auto sli =
-					new QListWidgetItem(QString::fromUtf8(obs_data_get_string(item, "name")), lsd->sceneList);
-				sli->setData(Qt::UserRole, QString::fromUtf8(obs_data_get_string(item, "uuid")));
-				lsd->sceneList->addItem(sli);
+				lsd->sceneIndex.Add(QString::fromUtf8(obs_data_get_string(item, "name")),
+						    QString::fromUtf8(obs_data_get_string(item, "uuid")));
 				obs_data_release(item);
 			}
 			obs_data_array_release(ls);
 		}
+		lsd->UpdatePreload();
 		auto main_canvas = obs_get_main_canvas();
 		if (main_canvas) {
 			auto sh = obs_canvas_get_signal_handler(main_canvas);
@@ -157,14 +157,14 @@ void LiveScenesDock::source_rename(void *data, calldata_t *call_data)
 	auto lsd = (LiveScenesDock *)data;
 	QString new_name = calldata_string(call_data, "new_name");
 	QString prev_name = calldata_string(call_data, "prev_name");
-	for (int i = 0; i < lsd->sceneList->count(); i++) {
-		auto item = lsd->sceneList->item(i);
+	auto source = (obs_source_t *)calldata_ptr(call_data, "source");
+	QString uuid = source ? QString::fromUtf8(obs_source_get_uuid(source)) : QString();
+	QMetaObject::invokeMethod(lsd, [lsd, uuid, prev_name, new_name] {
+		auto item = lsd->sceneIndex.FindByUuid(uuid);
 		if (!item)
-			continue;
-		if (item->text() == prev_name) {
-			item->setText(new_name);
-		}
-	}
+			item = lsd->sceneIndex.FindByName(prev_name);
+		lsd->sceneIndex.Rename(item, new_name);
+	});
 }
 
 void LiveScenesDock::MainSceneChanged()
@@ -173,32 +173,27 @@ void LiveScenesDock::MainSceneChanged()
 	if (!current_scene) {
 		if (sceneList->currentItem())
 			sceneList->setCurrentItem(nullptr);
+		preloader.Clear();
 		return;
 	}
 	QString scene_name = QString::fromUtf8(obs_source_get_name(current_scene));
 	QString scene_uuid = QString::fromUtf8(obs_source_get_uuid(current_scene));
 	obs_source_release(current_scene);
-	bool found = false;
-	for (int i = 0; i < sceneList->count(); i++) {
-		auto item = sceneList->item(i);
-		if (!item)
-			continue;
-		if (item->text() == scene_name) {
-			sceneList->setCurrentItem(item);
-			item->setSelected(true);
-			found = true;
-		} else if (item->data(Qt::UserRole).toString() == scene_uuid) {
-			sceneList->setCurrentItem(item);
-			item->setSelected(true);
-			item->setText(scene_name);
-			found = true;
-		} else if (item->isSelected()) {
-			item->setSelected(false);
-		}
+	auto item = sceneIndex.FindByName(scene_name);
+	if (!item) {
+		item = sceneIndex.FindByUuid(scene_uuid);
+		sceneIndex.Rename(item, scene_name);
 	}
-	if (!found && sceneList->currentItem()) {
-		sceneList->setCurrentItem(nullptr);
+	if (!item) {
+		if (sceneList->currentItem())
+			sceneList->setCurrentItem(nullptr);
+		UpdatePreload();
+		return;
 	}
+	if (sceneList->currentItem() != item)
+		sceneList->setCurrentItem(item);
+	item->setSelected(true);
+	UpdatePreload();
 }
 
 void LiveScenesDock::ChangeSceneIndex(bool relative, int offset, int invalidIdx)
@@ -226,6 +221,7 @@ void LiveScenesDock::ChangeSceneIndex(bool relative, int offset, int invalidIdx)
 	}
 	item->setSelected(true);
 	sceneList->blockSignals(false);
+	UpdatePreload();
 }
 
 obs_data_array_t *LiveScenesDock::GetLiveScenesArray()
@@ -252,11 +248,13 @@ bool LiveScenesDock::AddLiveScene(const QString &name)
 	if (!scene)
 		return false;
 
-	auto sli = new QListWidgetItem(name, sceneList);
-	sli->setData(Qt::UserRole, QString::fromUtf8(obs_source_get_uuid(scene)));
+	auto uuid = QString::fromUtf8(obs_source_get_uuid(scene));
 	obs_source_release(scene);
+	if (sceneIndex.FindByUuid(uuid))
+		return false;
 
-	sceneList->addItem(sli);
+	sceneIndex.Add(name, uuid);
+	UpdatePreload();
 	return true;
 }
 
@@ -264,14 +262,44 @@ bool LiveScenesDock::RemoveLiveScene(const QString &name)
 {
 	if (name.isEmpty())
 		return false;
-	for (int i = 0; i < sceneList->count(); i++) {
-		auto item = sceneList->item(i);
-		if (!item)
+	auto item = sceneIndex.FindByName(name);
+	if (!item)
+		return false;
+	sceneIndex.Remove(item);
+	UpdatePreload();
+	return true;
+}
+
+void LiveScenesDock::UpdatePreload()
+{
+	if (ScenePreloader::MaxScenes() <= 0) {
+		preloader.Clear();
+		return;
+	}
+	// the rundown runs top to bottom, so the next rows come first, then the previous row and the scenes marked to preload
+	const int current = sceneList->currentRow();
+	std::vector<obs_source_t *> candidates;
+	for (int row = current + 1; row < sceneList->count(); row++)
+		candidates.push_back(live_scene_source(sceneList->item(row)));
+	if (current > 0)
+		candidates.push_back(live_scene_source(sceneList->item(current - 1)));
+
+	auto current_scene = obs_frontend_get_current_scene();
+	struct obs_frontend_source_list scenes = {};
+	obs_frontend_get_scenes(&scenes);
+	for (size_t i = 0; i < scenes.sources.num; i++) {
+		auto scene = scenes.sources.array[i];
+		if (scene == current_scene)
 			continue;
-		if (item->text() == name) {
-			delete sceneList->takeItem(i);
-			return true;
-		}
+		auto ps = obs_source_get_private_settings(scene);
+		if (obs_data_get_bool(ps, "preload"))
+			candidates.push_back(obs_source_get_ref(scene));
+		obs_data_release(ps);
 	}
-	return false;
+	obs_frontend_source_list_free(&scenes);
+	obs_source_release(current_scene);
+
+	preloader.Update(candidates);
+	for (auto scene : candidates)
+		obs_source_release(scene);
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include "../utils/scene-index.hpp"
+#include "../utils/scene-preload.hpp"
 #include <QFrame>
 #include <QListWidget>
 #include <obs.h>
@@ -7,6 +9,8 @@ class LiveScenesDock : public QFrame {
 	Q_OBJECT
 private:
 	QListWidget *sceneList;
+	SceneIndex sceneIndex;
+	ScenePreloader preloader;
 
 	void ChangeSceneIndex(bool relative, int offset, int invalidIdx);
 
@@ -21,4 +25,5 @@ public:
 	obs_data_array_t *GetLiveScenesArray();
 	bool AddLiveScene(const QString &name);
 	bool RemoveLiveScene(const QString &name);
+	void UpdatePreload();
 };
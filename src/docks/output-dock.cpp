@@ -17,6 +17,7 @@
 #include <QToolButton>
 #include <src/utils/color.hpp>
 #include <src/utils/icon.hpp>
+#include <src/utils/registry.hpp>
 #include <util/config-file.h>
 #include <util/platform.h>
 
@@ -664,13 +665,8 @@ obs_data_array_t *OutputDock::GetOutputsArray()
 
 bool OutputDock::AddChapterToOutput(const char *output_name, const char *chapter_name)
 {
-	auto on = QString::fromUtf8(output_name);
-	for (auto it = outputWidgets.begin(); it != outputWidgets.end(); it++) {
-		if ((*it)->objectName() == on) {
-			return (*it)->AddChapter(chapter_name);
-		}
-	}
-	return false;
+	auto ow = registry_find_output(output_name);
+	return ow ? ow->AddChapter(chapter_name) : false;
 }
 
 void OutputDock::StartNextOutput()
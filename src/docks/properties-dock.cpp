@@ -18,6 +18,7 @@
 #include <QSpinBox>
 #include <QVBoxLayout>
 #include <src/utils/color.hpp>
+#include <src/utils/properties-cache.hpp>
 #include <src/utils/widgets/slider-ignore-scroll.hpp>
 #include <src/utils/widgets/double-slider.hpp>
 #include <src/utils/widgets/focus-scroll-spinbox.hpp>
@@ -25,7 +26,13 @@
 extern FiltersDock *filters_dock;
 extern TransformDock *transform_dock;
 
-PropertiesDock::PropertiesDock(QWidget *parent) : QFrame(parent)
+PropertiesDock::PropertiesDock(QWidget *parent)
+	: QFrame(parent),
+	  propertiesRefresh(this, [this] {
+		  OBSSourceAutoRelease source = obs_weak_source_get_source(pending_properties);
+		  pending_properties = nullptr;
+		  RebuildProperties(source);
+	  })
 {
 	auto sh = obs_get_signal_handler();
 	signal_handler_connect(sh, "canvas_create", canvas_create, this);
@@ -58,8 +65,14 @@ PropertiesDock::PropertiesDock(QWidget *parent) : QFrame(parent)
 	hl->addWidget(sourceTypeLabel, Qt::AlignRight);
 	vl->addLayout(hl);
 
-	layout = new QFormLayout;
-	vl->addLayout(layout);
+	loadingLabel = new QLabel(QString::fromUtf8(obs_module_text("LoadingProperties")));
+	loadingLabel->setAlignment(Qt::AlignCenter);
+	loadingLabel->setVisible(false);
+	vl->addWidget(loadingLabel);
+
+	panelsLayout = new QVBoxLayout;
+	panelsLayout->setContentsMargins(0, 0, 0, 0);
+	vl->addLayout(panelsLayout);
 	//QWidget *spacer = new QWidget();
 	//spacer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 	//vl->addWidget(spacer);
@@ -302,6 +315,12 @@ void PropertiesDock::SourceDeselected(OBSSource source)
 }
 
 void PropertiesDock::LoadProperties(OBSSource source)
+{
+	pending_properties = OBSGetWeakRef(source);
+	propertiesRefresh.Trigger();
+}
+
+void PropertiesDock::RebuildProperties(obs_source_t *source)
 {
 	if (current_properties) {
 		auto prev_source = obs_weak_source_get_source(current_properties);
@@ -312,14 +331,13 @@ void PropertiesDock::LoadProperties(OBSSource source)
 
 		obs_weak_source_release(current_properties);
 	}
-	for (int i = layout->rowCount() - 1; i >= 0; i--) {
-		layout->removeRow(i);
-	}
-	property_widgets.clear();
-	if (properties) {
-		obs_properties_destroy(properties);
-		properties = nullptr;
+	loadingLabel->setVisible(false);
+	if (panel) {
+		panel->settings_json = obs_data_get_json(panel->settings);
+		panel->widget->setVisible(false);
+		panel = nullptr;
 	}
+	PrunePanels();
 	if (!source) {
 		sourceLabel->setText(QString::fromUtf8(obs_module_text("NoSourceSelected")));
 		sourceTypeLabel->setText("");
@@ -341,21 +359,188 @@ void PropertiesDock::LoadProperties(OBSSource source)
 	}
 	sourceTypeLabel->setText(QString::fromUtf8(obs_source_get_display_name(obs_source_get_id(source))));
 
-	properties = obs_source_properties(source);
-	if (!properties)
-		return;
-
 	signal_handler_connect(obs_source_get_signal_handler(source), "update_properties", update_properties, this);
 	signal_handler_connect(obs_source_get_signal_handler(source), "remove", properties_remove, this);
 	signal_handler_connect(obs_source_get_signal_handler(source), "destroy", properties_remove, this);
 
-	obs_data_t *settings = obs_source_get_settings(source);
-	obs_property_t *property = obs_properties_first(properties);
+	OBSDataAutoRelease settings = obs_source_get_settings(source);
+	std::string uuid = obs_source_get_uuid(source);
+	auto it = panels.find(uuid);
+	if (it != panels.end()) {
+		panel = &it->second;
+		panel->widget->setVisible(true);
+		panel->used = ++panelUse;
+		if (panel->settings_json != obs_data_get_json(settings)) {
+			// changed while hidden, update the values in place and check the property tree still matches
+			RefreshValues(panel->properties.get(), panel->settings);
+			RevalidatePanel(source);
+		}
+		return;
+	}
+
+	loadingLabel->setVisible(true);
+	properties_cache_get(source, this, [this, uuid](std::shared_ptr<obs_properties_t> properties) {
+		OBSSourceAutoRelease s = obs_weak_source_get_source(current_properties);
+		if (!s || panel || uuid != obs_source_get_uuid(s))
+			return;
+		loadingLabel->setVisible(false);
+		BuildPanel(s, properties);
+	});
+}
+
+void PropertiesDock::BuildPanel(obs_source_t *source, std::shared_ptr<obs_properties_t> properties)
+{
+	if (!properties)
+		return;
+
+	auto it = panels.emplace(obs_source_get_uuid(source), PropertiesPanel()).first;
+	panel = &it->second;
+	panel->properties = properties;
+	panel->source = OBSGetWeakRef(source);
+	OBSDataAutoRelease settings = obs_source_get_settings(source);
+	panel->settings = settings.Get();
+	panel->widget = new QWidget;
+	panel->layout = new QFormLayout;
+	panel->layout->setContentsMargins(0, 0, 0, 0);
+	panel->widget->setLayout(panel->layout);
+	panelsLayout->addWidget(panel->widget);
+	panel->used = ++panelUse;
+
+	obs_property_t *property = obs_properties_first(properties.get());
 	while (property) {
-		AddProperty(properties, property, settings, layout);
+		AddProperty(properties.get(), property, panel->settings, panel->layout);
 		obs_property_next(&property);
 	}
-	obs_data_release(settings);
+
+	while (panels.size() > PROPERTIES_PANEL_CACHE_SIZE) {
+		auto oldest = panels.end();
+		for (auto i = panels.begin(); i != panels.end(); ++i) {
+			if (&i->second != panel && (oldest == panels.end() || i->second.used < oldest->second.used))
+				oldest = i;
+		}
+		if (oldest == panels.end())
+			break;
+		DestroyPanel(oldest);
+	}
+}
+
+void PropertiesDock::DestroyPanel(std::map<std::string, PropertiesPanel>::iterator it)
+{
+	if (panel == &it->second)
+		panel = nullptr;
+	// the widget lambdas hold raw pointers into the properties and settings freed below, silence them until deleted
+	it->second.widget->blockSignals(true);
+	for (auto child : it->second.widget->findChildren<QObject *>())
+		child->blockSignals(true);
+	it->second.widget->deleteLater();
+	panels.erase(it);
+}
+
+void PropertiesDock::PrunePanels()
+{
+	for (auto it = panels.begin(); it != panels.end();) {
+		OBSSourceAutoRelease source = obs_weak_source_get_source(it->second.source);
+		auto next = std::next(it);
+		if (!source || obs_source_removed(source))
+			DestroyPanel(it);
+		it = next;
+	}
+}
+
+static bool same_string(const char *a, const char *b)
+{
+	if (!a || !b)
+		return a == b;
+	return strcmp(a, b) == 0;
+}
+
+static bool same_properties(obs_properties_t *a, obs_properties_t *b)
+{
+	obs_property_t *pa = obs_properties_first(a);
+	obs_property_t *pb = obs_properties_first(b);
+	while (pa && pb) {
+		obs_property_type type = obs_property_get_type(pa);
+		if (type != obs_property_get_type(pb) || !same_string(obs_property_name(pa), obs_property_name(pb)) ||
+		    !same_string(obs_property_description(pa), obs_property_description(pb)))
+			return false;
+		if (type == OBS_PROPERTY_INT) {
+			if (obs_property_int_min(pa) != obs_property_int_min(pb) ||
+			    obs_property_int_max(pa) != obs_property_int_max(pb))
+				return false;
+		} else if (type == OBS_PROPERTY_FLOAT) {
+			if (obs_property_float_min(pa) != obs_property_float_min(pb) ||
+			    obs_property_float_max(pa) != obs_property_float_max(pb))
+				return false;
+		} else if (type == OBS_PROPERTY_LIST) {
+			size_t count = obs_property_list_item_count(pa);
+			if (count != obs_property_list_item_count(pb))
+				return false;
+			obs_combo_format format = obs_property_list_format(pa);
+			for (size_t i = 0; i < count; i++) {
+				if (!same_string(obs_property_list_item_name(pa, i), obs_property_list_item_name(pb, i)))
+					return false;
+				if (format == OBS_COMBO_FORMAT_INT &&
+				    obs_property_list_item_int(pa, i) != obs_property_list_item_int(pb, i))
+					return false;
+				if (format == OBS_COMBO_FORMAT_FLOAT &&
+				    obs_property_list_item_float(pa, i) != obs_property_list_item_float(pb, i))
+					return false;
+				if (format == OBS_COMBO_FORMAT_STRING &&
+				    !same_string(obs_property_list_item_string(pa, i), obs_property_list_item_string(pb, i)))
+					return false;
+			}
+		} else if (type == OBS_PROPERTY_GROUP) {
+			if (!same_properties(obs_property_group_content(pa), obs_property_group_content(pb)))
+				return false;
+		}
+		obs_property_next(&pa);
+		obs_property_next(&pb);
+	}
+	return !pa && !pb;
+}
+
+// visibility and enabled state are not part of the layout, they are taken over from the fresh tree
+static void sync_property_state(obs_properties_t *dst, obs_properties_t *src)
+{
+	obs_property_t *pd = obs_properties_first(dst);
+	obs_property_t *ps = obs_properties_first(src);
+	while (pd && ps) {
+		obs_property_set_visible(pd, obs_property_visible(ps));
+		obs_property_set_enabled(pd, obs_property_enabled(ps));
+		if (obs_property_get_type(pd) == OBS_PROPERTY_GROUP)
+			sync_property_state(obs_property_group_content(pd), obs_property_group_content(ps));
+		obs_property_next(&pd);
+		obs_property_next(&ps);
+	}
+}
+
+void PropertiesDock::UpdateProperties(OBSSource source)
+{
+	if (!panel || !obs_weak_source_references_source(current_properties, source))
+		return;
+
+	properties_cache_invalidate(source);
+	RevalidatePanel(source);
+}
+
+void PropertiesDock::RevalidatePanel(obs_source_t *source)
+{
+	std::string uuid = obs_source_get_uuid(source);
+	properties_cache_get(source, this, [this, uuid](std::shared_ptr<obs_properties_t> properties) {
+		auto it = panels.find(uuid);
+		if (it == panels.end() || panel != &it->second)
+			return;
+		if (properties && same_properties(panel->properties.get(), properties.get())) {
+			sync_property_state(panel->properties.get(), properties.get());
+			obs_properties_apply_settings(panel->properties.get(), panel->settings);
+			RefreshProperties(panel->properties.get(), panel->layout);
+			return;
+		}
+		OBSSourceAutoRelease s = obs_weak_source_get_source(panel->source);
+		DestroyPanel(it);
+		if (s)
+			BuildPanel(s, properties);
+	});
 }
 
 void PropertiesDock::source_remove(void *param, calldata_t *cd)
@@ -392,7 +577,17 @@ void PropertiesDock::update_properties(void *param, calldata_t *cd)
 	if (!obs_weak_source_references_source(this_->current_properties, source))
 		return;
 
-	QMetaObject::invokeMethod(this_, "LoadProperties", Qt::QueuedConnection, Q_ARG(OBSSource, OBSSource(source)));
+	QMetaObject::invokeMethod(this_, "UpdateProperties", Qt::QueuedConnection, Q_ARG(OBSSource, OBSSource(source)));
+}
+
+static void set_color_label(QLabel *colorLabel, const QColor &color, QColor::NameFormat format)
+{
+	QPalette palette = QPalette(color);
+	colorLabel->setText(color.name(format));
+	colorLabel->setPalette(palette);
+	colorLabel->setStyleSheet(QString("background-color :%1; color: %2;")
+					  .arg(palette.color(QPalette::Window).name(format))
+					  .arg(palette.color(QPalette::WindowText).name(format)));
 }
 
 void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *property, obs_data_t *settings, QFormLayout *layout)
@@ -413,7 +608,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 					w->setVisible(false);
 			}
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
 		connect(widget, &QCheckBox::checkStateChanged, [this, properties, property, settings, widget, layout] {
 #else
@@ -468,7 +663,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 			widget->setVisible(false);
 			label->setVisible(false);
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 		connect(spin, &QSpinBox::valueChanged, [this, properties, property, settings, spin, layout] {
 			if (obs_data_get_int(settings, obs_property_name(property)) == spin->value())
 				return;
@@ -518,7 +713,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 			widget->setVisible(false);
 			label->setVisible(false);
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 		connect(spin, &QDoubleSpinBox::valueChanged, [this, properties, property, settings, spin, layout] {
 			if (obs_data_get_double(settings, obs_property_name(property)) == spin->value())
 				return;
@@ -545,7 +740,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 				widget->setVisible(false);
 				label->setVisible(false);
 			}
-			property_widgets.emplace(property, widget);
+			panel->property_widgets.emplace(property, widget);
 			connect(widget, &QPlainTextEdit::textChanged, [this, properties, property, settings, widget, layout] {
 				auto t = widget->toPlainText().toUtf8();
 				if (strcmp(obs_data_get_string(settings, obs_property_name(property)), t.constData()) == 0)
@@ -603,7 +798,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 				if (label)
 					label->setVisible(false);
 			}
-			property_widgets.emplace(property, info_label);
+			panel->property_widgets.emplace(property, info_label);
 		} else {
 			auto widget = new QLineEdit();
 			widget->setText(QString::fromUtf8(obs_data_get_string(settings, obs_property_name(property))));
@@ -615,7 +810,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 				widget->setVisible(false);
 				label->setVisible(false);
 			}
-			property_widgets.emplace(property, widget);
+			panel->property_widgets.emplace(property, widget);
 
 			connect(widget, &QLineEdit::textChanged, [this, properties, property, settings, widget, layout] {
 				auto t = widget->text().toUtf8();
@@ -689,7 +884,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 			widget->setVisible(false);
 			label->setVisible(false);
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 		switch (format) {
 		case OBS_COMBO_FORMAT_INT:
 			connect(widget, &QComboBox::currentIndexChanged, [this, properties, property, settings, widget, layout] {
@@ -780,7 +975,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 		if (!obs_property_visible(property)) {
 			groupBox->setVisible(false);
 		}
-		property_widgets.emplace(property, groupBox);
+		panel->property_widgets.emplace(property, groupBox);
 
 		obs_properties_t *content = obs_property_group_content(property);
 		obs_property_t *el = obs_properties_first(content);
@@ -810,15 +1005,10 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 		if (type == OBS_PROPERTY_COLOR)
 			color.setAlpha(255);
 
-		QPalette palette = QPalette(color);
 		QLabel *colorLabel = new QLabel;
 		colorLabel->setEnabled(obs_property_enabled(property));
 		colorLabel->setFrameStyle(QFrame::Sunken | QFrame::Panel);
-		colorLabel->setText(color.name(format));
-		colorLabel->setPalette(palette);
-		colorLabel->setStyleSheet(QString("background-color :%1; color: %2;")
-						  .arg(palette.color(QPalette::Window).name(format))
-						  .arg(palette.color(QPalette::WindowText).name(format)));
+		set_color_label(colorLabel, color, format);
 		colorLabel->setAutoFillBackground(true);
 		colorLabel->setAlignment(Qt::AlignCenter);
 		colorLabel->setToolTip(QString::fromUtf8(obs_property_description(property)));
@@ -837,7 +1027,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 			widget->setVisible(false);
 			label->setVisible(false);
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 		bool supportAlpha = (type == OBS_PROPERTY_COLOR_ALPHA);
 		connect(button, &QPushButton::clicked,
 			[this, properties, property, settings, button, layout, supportAlpha, colorLabel, format] {
@@ -862,12 +1052,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 				if (color == initial)
 					return;
 
-				colorLabel->setText(color.name(format));
-				QPalette palette = QPalette(color);
-				colorLabel->setPalette(palette);
-				colorLabel->setStyleSheet(QString("background-color :%1; color: %2;")
-								  .arg(palette.color(QPalette::Window).name(format))
-								  .arg(palette.color(QPalette::WindowText).name(format)));
+				set_color_label(colorLabel, color, format);
 
 				obs_data_set_int(settings, obs_property_name(property), color_to_int(color));
 				if (obs_property_modified(property, settings)) {
@@ -886,7 +1071,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 		if (!obs_property_visible(property)) {
 			button->setVisible(false);
 		}
-		property_widgets.emplace(property, button);
+		panel->property_widgets.emplace(property, button);
 		connect(button, &QPushButton::clicked, [this, properties, property, settings, button, layout] {
 			obs_button_type type = obs_property_button_type(property);
 			auto savedUrl = QString::fromUtf8(obs_property_button_url(property));
@@ -934,7 +1119,7 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 			widget->setVisible(false);
 			label->setVisible(false);
 		}
-		property_widgets.emplace(property, widget);
+		panel->property_widgets.emplace(property, widget);
 		connect(button, &QPushButton::clicked, [this, property, settings, properties, layout, edit] {
 			QString startDir = edit->text();
 			if (startDir.isEmpty())
@@ -978,16 +1163,26 @@ void PropertiesDock::AddProperty(obs_properties_t *properties, obs_property_t *p
 
 void PropertiesDock::RefreshProperties(obs_properties_t *properties, QFormLayout *layout)
 {
+	if (!panel)
+		return;
 	obs_property_t *property = obs_properties_first(properties);
 	while (property) {
-		auto it = property_widgets.find(property);
-		if (it == property_widgets.end()) {
+		auto it = panel->property_widgets.find(property);
+		if (it == panel->property_widgets.end()) {
 			obs_property_next(&property);
 			continue;
 		}
 		auto widget = it->second;
+		const bool enabled = obs_property_enabled(property);
+		if (widget->testAttribute(Qt::WA_ForceDisabled) == enabled) {
+			widget->setEnabled(enabled);
+			if (obs_property_get_type(property) != OBS_PROPERTY_GROUP) {
+				for (auto child : widget->findChildren<QWidget *>(Qt::FindDirectChildrenOnly))
+					child->setEnabled(enabled);
+			}
+		}
 		auto visible = obs_property_visible(property);
-		if (widget->isVisible() != visible) {
+		if (widget->isHidden() == visible) {
 			widget->setVisible(visible);
 			int row = 0;
 			layout->getWidgetPosition(widget, &row, nullptr);
@@ -1007,6 +1202,87 @@ void PropertiesDock::RefreshProperties(obs_properties_t *properties, QFormLayout
 	}
 }
 
+// the change handlers return early when the widget already matches the settings, so setting values here does not write back
+void PropertiesDock::RefreshValues(obs_properties_t *properties, obs_data_t *settings)
+{
+	if (!panel)
+		return;
+	obs_property_t *property = obs_properties_first(properties);
+	for (; property; obs_property_next(&property)) {
+		auto it = panel->property_widgets.find(property);
+		if (it == panel->property_widgets.end())
+			continue;
+		QWidget *widget = it->second;
+		const char *name = obs_property_name(property);
+		obs_property_type type = obs_property_get_type(property);
+		if (type == OBS_PROPERTY_BOOL) {
+			static_cast<QCheckBox *>(widget)->setChecked(obs_data_get_bool(settings, name));
+		} else if (type == OBS_PROPERTY_INT) {
+			auto spin = qobject_cast<QSpinBox *>(widget);
+			if (!spin)
+				spin = widget->findChild<QSpinBox *>();
+			if (spin)
+				spin->setValue((int)obs_data_get_int(settings, name));
+		} else if (type == OBS_PROPERTY_FLOAT) {
+			auto spin = qobject_cast<QDoubleSpinBox *>(widget);
+			if (!spin)
+				spin = widget->findChild<QDoubleSpinBox *>();
+			if (spin)
+				spin->setValue(obs_data_get_double(settings, name));
+		} else if (type == OBS_PROPERTY_TEXT) {
+			auto text = QString::fromUtf8(obs_data_get_string(settings, name));
+			if (auto edit = qobject_cast<QPlainTextEdit *>(widget)) {
+				if (edit->toPlainText() != text)
+					edit->setPlainText(text);
+			} else if (auto edit = qobject_cast<QLineEdit *>(widget)) {
+				if (edit->text() != text)
+					edit->setText(text);
+			}
+		} else if (type == OBS_PROPERTY_LIST) {
+			auto combo = static_cast<QComboBox *>(widget);
+			QVariant value;
+			switch (obs_property_list_format(property)) {
+			case OBS_COMBO_FORMAT_INT:
+				value = QVariant::fromValue(obs_data_get_int(settings, name));
+				break;
+			case OBS_COMBO_FORMAT_FLOAT:
+				value = QVariant::fromValue(obs_data_get_double(settings, name));
+				break;
+			case OBS_COMBO_FORMAT_STRING:
+				value = QByteArray(obs_data_get_string(settings, name));
+				break;
+			default:;
+			}
+			if (combo->isEditable()) {
+				combo->lineEdit()->setText(value.toString());
+			} else {
+				auto idx = combo->findData(value);
+				if (idx != -1)
+					combo->setCurrentIndex(idx);
+			}
+		} else if (type == OBS_PROPERTY_GROUP) {
+			auto groupBox = static_cast<QGroupBox *>(widget);
+			if (groupBox->isCheckable())
+				groupBox->setChecked(obs_data_get_bool(settings, name));
+			obs_properties_t *content = obs_property_group_content(property);
+			if (content)
+				RefreshValues(content, settings);
+		} else if (type == OBS_PROPERTY_COLOR || type == OBS_PROPERTY_COLOR_ALPHA) {
+			auto colorLabel = widget->findChild<QLabel *>();
+			if (!colorLabel)
+				continue;
+			QColor color = color_from_int(obs_data_get_int(settings, name));
+			if (type == OBS_PROPERTY_COLOR)
+				color.setAlpha(255);
+			set_color_label(colorLabel, color, type == OBS_PROPERTY_COLOR_ALPHA ? QColor::HexArgb : QColor::HexRgb);
+		} else if (type == OBS_PROPERTY_PATH) {
+			auto edit = widget->findChild<QLineEdit *>();
+			if (edit)
+				edit->setText(QString::fromUtf8(obs_data_get_string(settings, name)));
+		}
+	}
+}
+
 void PropertiesDock::scene_item_transform(void *param, calldata_t *cd)
 {
 	UNUSED_PARAMETER(param);
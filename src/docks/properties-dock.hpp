@@ -1,12 +1,30 @@
 #pragma once
 
+#include "../utils/refresh-coalescer.hpp"
 #include <obs.h>
 #include <obs.hpp>
 #include <QComboBox>
 #include <QFormLayout>
 #include <QFrame>
 #include <QLabel>
+#include <QVBoxLayout>
 #include <obs-frontend-api.h>
+#include <map>
+#include <memory>
+#include <string>
+
+#define PROPERTIES_PANEL_CACHE_SIZE 8
+
+struct PropertiesPanel {
+	QWidget *widget = nullptr;
+	QFormLayout *layout = nullptr;
+	std::shared_ptr<obs_properties_t> properties;
+	OBSWeakSource source;
+	OBSData settings;
+	std::string settings_json;
+	std::map<obs_property_t *, QWidget *> property_widgets;
+	uint64_t used = 0;
+};
 
 class PropertiesDock : public QFrame {
 	Q_OBJECT
@@ -18,14 +36,25 @@ private:
 	obs_weak_source_t *current_source = nullptr;
 	obs_weak_source_t *current_properties = nullptr;
 
-	obs_properties_t *properties = nullptr;
+	OBSWeakSource pending_properties;
+	RefreshCoalescer propertiesRefresh;
 
-	QFormLayout *layout = nullptr;
+	QLabel *loadingLabel = nullptr;
+	QVBoxLayout *panelsLayout = nullptr;
 
-	std::map<obs_property_t *, QWidget *> property_widgets;
+	std::map<std::string, PropertiesPanel> panels;
+	PropertiesPanel *panel = nullptr;
+	uint64_t panelUse = 0;
+
+	void BuildPanel(obs_source_t *source, std::shared_ptr<obs_properties_t> properties);
+	void DestroyPanel(std::map<std::string, PropertiesPanel>::iterator it);
+	void PrunePanels();
 
 	void AddProperty(obs_properties_t *properties, obs_property_t *property, obs_data_t *settings, QFormLayout *layout);
 	void RefreshProperties(obs_properties_t *properties, QFormLayout *layout);
+	void RefreshValues(obs_properties_t *properties, obs_data_t *settings);
+	void RebuildProperties(obs_source_t *source);
+	void RevalidatePanel(obs_source_t *source);
 
 	static void canvas_create(void *param, calldata_t *cd);
 	static void canvas_channel_change(void *param, calldata_t *cd);
@@ -47,6 +76,7 @@ private slots:
 	void SourceChanged(OBSSource source);
 	void SourceDeselected(OBSSource source);
 	void LoadProperties(OBSSource source);
+	void UpdateProperties(OBSSource source);
 public:
 	PropertiesDock(QWidget *parent = nullptr);
 	~PropertiesDock();
@@ -1,5 +1,8 @@
 #include "../dialogs/name-dialog.hpp"
+#include "../utils/scene-links.hpp"
+#include "../utils/switch-latency.hpp"
 #include "canvas-dock.hpp"
+#include "live-scenes-dock.hpp"
 #include "scenes-dock.hpp"
 #include "sources-dock.hpp"
 #include "transitions-dock.hpp"
@@ -16,12 +19,12 @@
 #include <QToolBar>
 #include <QVBoxLayout>
 #include <QWidgetAction>
-#include <src/utils/obs-websocket-api.h>
+#include <src/utils/vendor-events.hpp>
 #include <src/utils/widgets/focus-scroll-spinbox.hpp>
 
-extern obs_websocket_vendor vendor;
 extern SourcesDock *sources_dock;
 extern TransitionsDock *transitions_dock;
+extern LiveScenesDock *live_scenes_dock;
 
 ScenesDock::ScenesDock(QWidget *parent) : QFrame(parent)
 {
@@ -31,6 +34,7 @@ ScenesDock::ScenesDock(QWidget *parent) : QFrame(parent)
 	auto mainLayout = new QVBoxLayout(this);
 	mainLayout->setContentsMargins(0, 0, 0, 0);
 	sceneList = new QListWidget();
+	sceneIndex.Bind(sceneList);
 	sceneList->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
 	sceneList->setFrameShape(QFrame::NoFrame);
 	sceneList->setFrameShadow(QFrame::Plain);
@@ -77,6 +81,7 @@ ScenesDock::ScenesDock(QWidget *parent) : QFrame(parent)
 		}
 		if (scene && scene != current) {
 			if (canvasDock) {
+				switch_latency_request(canvasDock->GetCanvas(), "list");
 				canvasDock->SwitchScene(QString::fromUtf8(obs_source_get_name(scene)));
 			} else {
 				auto mc = obs_get_main_canvas();
@@ -274,7 +279,7 @@ void ScenesDock::SwitchToCanvas(obs_canvas_t *c)
 	if (transitions_dock) {
 		transitions_dock->SetCanvas(c, canvasDock);
 	}
-	sceneList->clear();
+	sceneIndex.Clear();
 	if (!canvas) {
 		return;
 	}
@@ -297,10 +302,7 @@ void ScenesDock::SwitchToCanvas(obs_canvas_t *c)
 			auto sh = obs_source_get_signal_handler(scene);
 			signal_handler_disconnect(sh, "rename", scene_rename, this);
 			signal_handler_connect(sh, "rename", scene_rename, this);
-			auto sn = QString::fromUtf8(obs_source_get_name(scene));
-			auto sli = new QListWidgetItem(sn, sceneList);
-			sli->setData(Qt::UserRole, QString::fromUtf8(obs_source_get_uuid(scene)));
-			sceneList->addItem(sli);
+			sceneIndex.Add(scene);
 		}
 		obs_frontend_source_list_free(&scenes);
 	} else {
@@ -310,11 +312,7 @@ void ScenesDock::SwitchToCanvas(obs_canvas_t *c)
 				auto sh = obs_source_get_signal_handler(scene);
 				signal_handler_disconnect(sh, "rename", scene_rename, param);
 				signal_handler_connect(sh, "rename", scene_rename, param);
-				auto self = (ScenesDock *)param;
-				auto sn = QString::fromUtf8(obs_source_get_name(scene));
-				auto sli = new QListWidgetItem(sn, self->sceneList);
-				sli->setData(Qt::UserRole, QString::fromUtf8(obs_source_get_uuid(scene)));
-				self->sceneList->addItem(sli);
+				((ScenesDock *)param)->sceneIndex.Add(scene);
 				return true;
 			},
 			this);
@@ -334,37 +332,20 @@ void ScenesDock::UpdateLinkedScenes()
 		item->setIcon(QIcon(":/aitum/media/unlinked.svg"));
 	}
 	auto c = obs_weak_canvas_get_canvas(canvas);
-	auto cn = obs_canvas_get_name(c);
+	if (!c) {
+		return;
+	}
+	auto cn = std::string(obs_canvas_get_name(c));
 	obs_canvas_release(c);
-	struct obs_frontend_source_list scenes = {};
-	obs_frontend_get_scenes(&scenes);
-	for (size_t i = 0; i < scenes.sources.num; i++) {
-		obs_source_t *src = scenes.sources.array[i];
-		obs_data_t *settings = obs_source_get_settings(src);
-		auto c = obs_data_get_array(settings, "canvas");
-		if (c) {
-			const auto count = obs_data_array_count(c);
-			for (size_t j = 0; j < count; j++) {
-				auto item = obs_data_array_item(c, j);
-				if (!item) {
-					continue;
-				}
-				if (strcmp(obs_data_get_string(item, "name"), cn) == 0) {
-					auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-					auto sil = sceneList->findItems(sn, Qt::MatchExactly);
-					for (auto &si : sil) {
-						si->setIcon(QIcon(":/aitum/media/linked.svg"));
-					}
-				}
-				obs_data_release(item);
-			}
-
-			obs_data_array_release(c);
+	if (canvasDock) {
+		scene_links_adopt(cn.c_str(), canvasDock->GetCanvasWidth(), canvasDock->GetCanvasHeight());
+	}
+	for (const auto &sn : scene_links_canvas_scenes(cn.c_str())) {
+		auto si = sceneIndex.FindByName(QString::fromUtf8(sn.c_str()));
+		if (si) {
+			si->setIcon(QIcon(":/aitum/media/linked.svg"));
 		}
-
-		obs_data_release(settings);
 	}
-	obs_frontend_source_list_free(&scenes);
 }
 
 void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
@@ -528,6 +509,9 @@ void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 		OBSDataAutoRelease ps = obs_source_get_private_settings(source);
 		obs_source_release(source);
 		obs_data_set_string(ps, "transition", "");
+		if (canvasDock) {
+			canvasDock->PrepareTransitions();
+		}
 	});
 
 	if (canvasDock) {
@@ -555,6 +539,9 @@ void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 				OBSDataAutoRelease ps = obs_source_get_private_settings(source);
 				obs_source_release(source);
 				obs_data_set_string(ps, "transition", a2->text().toUtf8().constData());
+				if (canvasDock) {
+					canvasDock->PrepareTransitions();
+				}
 			});
 		}
 	} else {
@@ -625,11 +612,15 @@ void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 		auto linkedScenesMenu = menu.addMenu(QString::fromUtf8(obs_module_text("LinkedScenes")));
 		connect(linkedScenesMenu, &QMenu::aboutToShow, [linkedScenesMenu, this] {
 			linkedScenesMenu->clear();
+			auto cc = obs_weak_canvas_get_canvas(canvas);
+			auto cn = std::string(cc ? obs_canvas_get_name(cc) : "");
+			obs_canvas_release(cc);
+			const auto current = sceneList->currentItem() ? sceneList->currentItem()->text().toStdString()
+								      : std::string();
 			struct obs_frontend_source_list scenes = {};
 			obs_frontend_get_scenes(&scenes);
 			for (size_t i = 0; i < scenes.sources.num; i++) {
 				obs_source_t *src = scenes.sources.array[i];
-				obs_data_t *settings = obs_source_get_settings(src);
 
 				auto name = QString::fromUtf8(obs_source_get_name(src));
 				auto *checkBox = new QCheckBox(name, linkedScenesMenu);
@@ -647,29 +638,9 @@ void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 				checkableAction->setDefaultWidget(checkBox);
 				linkedScenesMenu->addAction(checkableAction);
 
-				auto cc = obs_weak_canvas_get_canvas(canvas);
-				auto c = obs_data_get_array(settings, "canvas");
-				if (c) {
-					const auto count = obs_data_array_count(c);
-
-					for (size_t j = 0; j < count; j++) {
-						auto item = obs_data_array_item(c, j);
-						if (!item)
-							continue;
-						if (strcmp(obs_data_get_string(item, "name"), obs_canvas_get_name(cc)) == 0) {
-							auto sn = QString::fromUtf8(obs_data_get_string(item, "scene"));
-							if (sn == sceneList->currentItem()->text()) {
-								checkBox->setChecked(true);
-							}
-						}
-						obs_data_release(item);
-					}
-
-					obs_data_array_release(c);
+				if (!current.empty() && scene_links_get(src, cn.c_str()) == current) {
+					checkBox->setChecked(true);
 				}
-				obs_canvas_release(cc);
-
-				obs_data_release(settings);
 			}
 			obs_frontend_source_list_free(&scenes);
 		});
@@ -715,6 +686,28 @@ void ScenesDock::ShowScenesContextMenu(QListWidgetItem *widget_item)
 	a->setCheckable(true);
 	obs_data_set_default_bool(private_settings, "show_in_multiview", true);
 	a->setChecked(obs_data_get_bool(private_settings, "show_in_multiview"));
+
+	a = menu.addAction(QString::fromUtf8(obs_module_text("PreloadScene")), [this, scene_name, scene_uuid](bool checked) {
+		auto source = obs_get_source_by_uuid(scene_uuid.c_str());
+		if (!source) {
+			auto c = obs_weak_canvas_get_canvas(canvas);
+			if (!c) {
+				return;
+			}
+			source = obs_canvas_get_source_by_name(c, scene_name.c_str());
+			obs_canvas_release(c);
+		}
+		OBSDataAutoRelease ps = obs_source_get_private_settings(source);
+		obs_source_release(source);
+		obs_data_set_bool(ps, "preload", checked);
+		if (canvasDock) {
+			canvasDock->UpdatePreload();
+		} else if (live_scenes_dock) {
+			live_scenes_dock->UpdatePreload();
+		}
+	});
+	a->setCheckable(true);
+	a->setChecked(obs_data_get_bool(private_settings, "preload"));
 	menu.exec(QCursor::pos());
 }
 
@@ -784,12 +777,12 @@ void ScenesDock::AddScene(QString duplicate, bool ask_name)
 			auto sh = obs_source_get_signal_handler(new_scene);
 			signal_handler_connect(sh, "rename", scene_rename, this);
 		}
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_SCENES)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "canvas", obs_canvas_get_name(c));
 			obs_data_set_string(d, "name", obs_source_get_name(new_scene));
 			obs_data_set_string(d, "uuid", obs_source_get_uuid(new_scene));
-			obs_websocket_vendor_emit_event(vendor, "scene_added", d);
+			vendor_emit_event(VENDOR_EVENT_SCENES, "scene_added", d);
 			obs_data_release(d);
 		}
 		//auto sn = QString::fromUtf8(obs_source_get_name(new_scene));
@@ -831,12 +824,12 @@ void ScenesDock::RemoveCurrentScene()
 		std::string canvas_name = c ? obs_canvas_get_name(c) : "";
 		obs_canvas_release(c);
 		obs_source_remove(s);
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_SCENES)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "canvas", canvas_name.c_str());
 			obs_data_set_string(d, "name", obs_source_get_name(s));
 			obs_data_set_string(d, "uuid", obs_source_get_uuid(s));
-			obs_websocket_vendor_emit_event(vendor, "scene_removed", d);
+			vendor_emit_event(VENDOR_EVENT_SCENES, "scene_removed", d);
 			obs_data_release(d);
 		}
 	}
@@ -849,37 +842,34 @@ void ScenesDock::scene_add(void *data, calldata_t *cd)
 	auto scene = (obs_source_t *)calldata_ptr(cd, "source");
 	auto self = (ScenesDock *)data;
 	auto sn = QString::fromUtf8(obs_source_get_name(scene));
-	auto sli = new QListWidgetItem(sn, self->sceneList);
-	sli->setData(Qt::UserRole, QString::fromUtf8(obs_source_get_uuid(scene)));
-	self->sceneList->addItem(sli);
+	auto uuid = QString::fromUtf8(obs_source_get_uuid(scene));
+	auto canvas = obs_source_get_canvas(scene);
+	obs_canvas_release(canvas);
+	QMetaObject::invokeMethod(self, [self, sn, uuid, canvas] {
+		auto c = obs_weak_canvas_get_canvas(self->canvas);
+		obs_canvas_release(c);
+		if (c != canvas || self->sceneIndex.FindByUuid(uuid))
+			return;
+		self->sceneIndex.Add(sn, uuid);
+	});
 }
 
 void ScenesDock::scene_remove(void *data, calldata_t *cd)
 {
 	auto scene = (obs_source_t *)calldata_ptr(cd, "source");
 	auto self = (ScenesDock *)data;
-	auto items = self->sceneList->findItems(QString::fromUtf8(obs_source_get_name(scene)), Qt::MatchExactly);
-	if (items.isEmpty()) {
-		return;
-	}
-	self->sceneList->takeItem(self->sceneList->row(items.first()));
+	auto uuid = QString::fromUtf8(obs_source_get_uuid(scene));
+	QMetaObject::invokeMethod(self, [self, uuid] { self->sceneIndex.Remove(self->sceneIndex.FindByUuid(uuid)); });
 }
 
 void ScenesDock::scene_rename(void *data, calldata_t *cd)
 {
 	auto new_name = calldata_string(cd, "new_name");
-	auto prev_name = calldata_string(cd, "prev_name");
 	auto scene = (obs_source_t *)calldata_ptr(cd, "source");
 	auto self = (ScenesDock *)data;
-	auto items = self->sceneList->findItems(QString::fromUtf8(prev_name), Qt::MatchExactly);
-	if (items.isEmpty()) {
-		return;
-	}
-	auto item = items.first();
-	if (item->data(Qt::UserRole).toString() != QString::fromUtf8(obs_source_get_uuid(scene))) {
-		return;
-	}
-	item->setText(QString::fromUtf8(new_name));
+	auto uuid = QString::fromUtf8(obs_source_get_uuid(scene));
+	auto name = QString::fromUtf8(new_name);
+	QMetaObject::invokeMethod(self, [self, uuid, name] { self->sceneIndex.Rename(self->sceneIndex.FindByUuid(uuid), name); });
 }
 
 void ScenesDock::channel_change(void *data, calldata_t *cd)
@@ -923,15 +913,12 @@ void ScenesDock::UpdateCurrentScene()
 	if (sources_dock) {
 		sources_dock->SetScene(current_scene);
 	}
-	auto items = sceneList->findItems(QString::fromUtf8(obs_source_get_name(current_scene)), Qt::MatchExactly);
+	auto item = sceneIndex.Find(current_scene);
 	obs_source_release(current_scene);
-	if (items.isEmpty()) {
-		return;
-	}
-	if (sceneList->currentItem() == items.first()) {
+	if (!item || sceneList->currentItem() == item) {
 		return;
 	}
-	sceneList->setCurrentItem(items.first());
+	sceneList->setCurrentItem(item);
 }
 
 void ScenesDock::transition_action(void *data, calldata_t *cd)
@@ -1,4 +1,5 @@
 #pragma once
+#include "../utils/scene-index.hpp"
 #include <QFrame>
 #include <QListWidget>
 #include <QDockWidget>
@@ -11,6 +12,7 @@ private:
 	obs_weak_canvas_t *canvas = nullptr;
 	obs_weak_source_t *transition = nullptr;
 	QListWidget *sceneList;
+	SceneIndex sceneIndex;
 
 	void ChangeSceneIndex(bool relative, int offset, int invalidIdx);
 	void SwitchToCanvas(obs_canvas_t *new_canvas);
@@ -269,6 +269,7 @@ obs_sceneitem_t *SourcesDock::GetCurrentSceneItem()
 
 int SourcesDock::GetTopSelectedSourceItem()
 {
+	sourceList->FlushSceneChanged();
 	QModelIndexList selectedItems = sourceList->selectionModel()->selectedIndexes();
 	return selectedItems.isEmpty() ? -1 : selectedItems[0].row();
 }
@@ -296,7 +297,7 @@ void SourcesDock::SetScene(obs_source_t *s)
 		signal_handler_connect(sh, "reorder", SceneReordered, this);
 		signal_handler_connect(sh, "refresh", SceneRefreshed, this);
 	}
-	sourceList->GetStm()->SceneChanged();
+	sourceList->QueueSceneChanged();
 }
 
 void SourcesDock::SceneItemAdded(void *data, calldata_t *params)
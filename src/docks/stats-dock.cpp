@@ -7,6 +7,10 @@
 #include <QTableView>
 #include <QVBoxLayout>
 #include <src/utils/color.hpp>
+#include <src/utils/preview-texture.hpp>
+#include <src/utils/switch-latency.hpp>
+#include <src/utils/vendor-events.hpp>
+#include <util/platform.h>
 
 extern obs_data_t *current_profile_config;
 extern QTabBar *modesTabBar;
@@ -20,7 +24,7 @@ StatsDock::StatsDock(QWidget *parent) : QFrame(parent)
 	table->setEditTriggers(QAbstractItemView::NoEditTriggers);
 	table->setSortingEnabled(true);
 
-	model = new OutputStatsModel([this]() { return isVisible(); });
+	model = new OutputStatsModel([this]() { return isVisible() || vendor_stats_interval() != 0; });
 	model->setGraphWidthFunc([this](int i) { return table->columnWidth(i); });
 	auto proxyModel = new QSortFilterProxyModel(this);
 	proxyModel->setSourceModel(model);
@@ -172,8 +176,19 @@ QVariant OutputStatsModel::headerData(int section, Qt::Orientation orientation,
 	return QVariant();
 }
 
+static uint32_t per_second(uint64_t delta, uint64_t elapsed_ns)
+{
+	return elapsed_ns ? (uint32_t)((double)delta * 1000000000.0 / (double)elapsed_ns) : (uint32_t)delta;
+}
+
 void OutputStatsModel::updateStats()
 {
+	// websocket subscribers share this sampler, so it runs at their interval when that is shorter than a second
+	auto stats_interval = vendor_stats_interval();
+	int interval = stats_interval && stats_interval < 1000 ? (int)stats_interval : 1000;
+	if (updateTimer.interval() != interval)
+		updateTimer.setInterval(interval);
+
 	bool new_active = isActiveFunc();
 	if (new_active != active) {
 		active = new_active;
@@ -181,10 +196,16 @@ void OutputStatsModel::updateStats()
 			beginResetModel();
 			rows.clear();
 			endResetModel();
+			last_sample_ns = 0;
+			graph_elapsed_ns = 0;
+			stats_emitted_ns = 0;
 		}
 	}
 	if (!active)
 		return;
+	const uint64_t now_ns = os_gettime_ns();
+	sample_elapsed_ns = last_sample_ns ? now_ns - last_sample_ns : 1000000000ULL;
+	last_sample_ns = now_ns;
 	for (auto &row : rows) {
 		row.updated = false;
 	}
@@ -200,7 +221,8 @@ void OutputStatsModel::updateStats()
 					if (encoder_type == OBS_ENCODER_VIDEO) {
 						auto encoded_frames = obs_encoder_get_encoded_frames(encoder);
 						row.encoded_fps = encoded_frames > row.encoded_frames
-									  ? encoded_frames - row.encoded_frames
+									  ? per_second(encoded_frames - row.encoded_frames,
+										       model->sample_elapsed_ns)
 									  : 0;
 						row.encoded_frames = encoded_frames;
 						row.updated = true;
@@ -260,12 +282,16 @@ void OutputStatsModel::updateStats()
 					row.active_delay = obs_output_get_active_delay(output);
 					row.dropped_frames = obs_output_get_frames_dropped(output);
 					auto output_bytes = obs_output_get_total_bytes(output);
+					auto elapsed_ns = model->sample_elapsed_ns;
 					row.output_bitrate =
-						output_bytes > row.output_bytes ? (output_bytes - row.output_bytes) * 8 / 1000 : 0;
+						output_bytes > row.output_bytes
+							? per_second((output_bytes - row.output_bytes) * 8, elapsed_ns) / 1000
+							: 0;
 					row.output_bytes = output_bytes;
 					auto output_frames = obs_output_get_total_frames(output);
-					row.output_fps = output_frames > (int)row.output_frames ? output_frames - row.output_frames
-												: 0;
+					row.output_fps = output_frames > (int)row.output_frames
+								 ? per_second(output_frames - row.output_frames, elapsed_ns)
+								 : 0;
 					row.output_frames = output_frames;
 					row.updated = true;
 					model->rows_changed.insert(index);
@@ -322,8 +348,10 @@ void OutputStatsModel::updateStats()
 		},
 		this);
 
-	if (rows.empty())
+	if (rows.empty()) {
+		emitStats(now_ns);
 		return;
+	}
 
 	obs_enum_canvases(
 		[](void *data, obs_canvas_t *canvas) {
@@ -340,13 +368,36 @@ void OutputStatsModel::updateStats()
 				if (row.canvas == canvas || row.video == video) {
 					row.skipped_frames = video_output_get_skipped_frames(video);
 					auto canvas_frames = video_output_get_total_frames(video);
-					row.canvas_fps = canvas_frames > row.canvas_frames ? canvas_frames - row.canvas_frames : 0;
+					auto elapsed_ns = model->sample_elapsed_ns;
+					row.canvas_fps = canvas_frames > row.canvas_frames
+								 ? per_second(canvas_frames - row.canvas_frames, elapsed_ns)
+								 : 0;
 					row.canvas_frames = canvas_frames;
 					struct obs_video_info ovi;
 					if (obs_canvas_get_video_info(canvas, &ovi)) {
 						row.canvas_width = ovi.base_width;
 						row.canvas_height = ovi.base_height;
 					}
+					struct preview_texture_stats pts;
+					if (preview_texture_get_stats(canvas, &pts)) {
+						auto renders = pts.renders - row.preview_renders;
+						auto draws = pts.draws - row.preview_draws;
+						auto render_ns = pts.render_ns - row.preview_render_ns;
+						auto saved = draws > renders ? draws - renders : 0;
+						row.preview_renders_ps = per_second(renders, elapsed_ns);
+						row.preview_saved_ps = per_second(saved, elapsed_ns);
+						row.preview_time_saved = renders ? (double)render_ns / (double)renders *
+											   (double)row.preview_saved_ps / 1000000.0
+										 : 0.0;
+						row.preview_renders = pts.renders;
+						row.preview_draws = pts.draws;
+						row.preview_render_ns = pts.render_ns;
+					}
+					struct switch_latency_stats sls = {};
+					switch_latency_get_stats(canvas, &sls);
+					row.switches = sls.switches;
+					row.switch_latency_ms = (double)sls.last_ns / 1000000.0;
+					row.switch_latency_p95_ms = switch_latency_percentile_ms(&sls, 0.95);
 					model->rows_changed.insert(index);
 				}
 				++index;
@@ -360,15 +411,22 @@ void OutputStatsModel::updateStats()
 	auto palette = QPalette();
 	auto line_color = palette.text().color().rgba();
 	auto graph_color = palette.highlight().color().rgba();
+	// graphs keep one column per second regardless of how fast the sampler runs
+	graph_elapsed_ns += sample_elapsed_ns;
+	bool update_graphs = graph_elapsed_ns + sample_elapsed_ns / 2 >= 1000000000ULL;
+	if (update_graphs)
+		graph_elapsed_ns = 0;
 	for (auto &row : rows) {
-		updateGraph(&row.output_bitrate_graph, row.output_bitrate, &row.output_bitrate_max, row.output_bitrate_graph_width,
-			    row.row_height, line_color, graph_color);
-		updateGraph(&row.output_fps_graph, row.output_fps, &row.output_fps_max, row.output_fps_graph_width, row.row_height,
-			    line_color, graph_color);
-		updateGraph(&row.encoded_fps_graph, row.encoded_fps, &row.encoded_fps_max, row.encoded_fps_graph_width,
-			    row.row_height, line_color, graph_color);
-		updateGraph(&row.canvas_fps_graph, row.canvas_fps, &row.canvas_fps_max, row.canvas_fps_graph_width, row.row_height,
-			    line_color, graph_color);
+		if (update_graphs) {
+			updateGraph(&row.output_bitrate_graph, row.output_bitrate, &row.output_bitrate_max,
+				    row.output_bitrate_graph_width, row.row_height, line_color, graph_color);
+			updateGraph(&row.output_fps_graph, row.output_fps, &row.output_fps_max, row.output_fps_graph_width,
+				    row.row_height, line_color, graph_color);
+			updateGraph(&row.encoded_fps_graph, row.encoded_fps, &row.encoded_fps_max, row.encoded_fps_graph_width,
+				    row.row_height, line_color, graph_color);
+			updateGraph(&row.canvas_fps_graph, row.canvas_fps, &row.canvas_fps_max, row.canvas_fps_graph_width,
+				    row.row_height, line_color, graph_color);
+		}
 		if (row.updated) {
 			row.last_update = now;
 			++idx;
@@ -384,6 +442,8 @@ void OutputStatsModel::updateStats()
 		++idx;
 	}
 
+	emitStats(now_ns);
+
 	if (rows_changed.empty())
 		return;
 	auto min_row = *std::min_element(rows_changed.begin(), rows_changed.end());
@@ -392,6 +452,51 @@ void OutputStatsModel::updateStats()
 	emit dataChanged(index(min_row, 0), index(max_row, (int)columns.size() - 1), {Qt::DisplayRole, Qt::UserRole});
 }
 
+void OutputStatsModel::emitStats(uint64_t now)
+{
+	auto interval = vendor_stats_interval();
+	if (!interval || !vendor_event_wanted(VENDOR_EVENT_STATS))
+		return;
+	const uint64_t interval_ns = (uint64_t)interval * 1000000ULL;
+	if (stats_emitted_ns && now - stats_emitted_ns + sample_elapsed_ns / 2 < interval_ns)
+		return;
+	auto elapsed_ns = stats_emitted_ns ? now - stats_emitted_ns : sample_elapsed_ns;
+	stats_emitted_ns = now;
+
+	auto d = obs_data_create();
+	obs_data_set_int(d, "interval_ms", interval);
+	obs_data_set_int(d, "elapsed_ms", (long long)(elapsed_ns / 1000000ULL));
+	auto oa = obs_data_array_create();
+	for (auto &row : rows) {
+		auto o = obs_data_create();
+		if (row.output)
+			obs_data_set_string(o, "name", row.output_name.c_str());
+		if (row.encoder)
+			obs_data_set_string(o, "encoder", row.encoder_name.c_str());
+		if (row.canvas)
+			obs_data_set_string(o, "canvas", row.canvas_name.c_str());
+		obs_data_set_int(o, "fps", row.output_fps);
+		obs_data_set_int(o, "bitrate", row.output_bitrate);
+		obs_data_set_int(o, "total_frames", row.output_frames);
+		obs_data_set_int(o, "total_bytes", (long long)row.output_bytes);
+		obs_data_set_int(o, "dropped_frames", row.dropped_frames);
+		obs_data_set_int(o, "skipped_frames", row.skipped_frames);
+		obs_data_set_int(o, "active_delay", row.active_delay);
+		obs_data_set_int(o, "encoded_fps", row.encoded_fps);
+		obs_data_set_int(o, "canvas_fps", row.canvas_fps);
+		if (row.switches) {
+			obs_data_set_double(o, "switch_latency_ms", row.switch_latency_ms);
+			obs_data_set_double(o, "switch_latency_p95_ms", row.switch_latency_p95_ms);
+		}
+		obs_data_array_push_back(oa, o);
+		obs_data_release(o);
+	}
+	obs_data_set_array(d, "outputs", oa);
+	obs_data_array_release(oa);
+	vendor_emit_event(VENDOR_EVENT_STATS, "stats", d);
+	obs_data_release(d);
+}
+
 void OutputStatsModel::updateGraph(QImage *graph, uint32_t value, uint32_t *max_value, int width, int height, uint line_color,
 				   uint graph_color)
 {
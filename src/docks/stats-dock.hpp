@@ -46,6 +46,15 @@ struct OutputStatsRow {
 	uint32_t canvas_fps_max = 0;
 	uint32_t canvas_width = 0;
 	uint32_t canvas_height = 0;
+	uint64_t preview_renders = 0;
+	uint64_t preview_draws = 0;
+	uint64_t preview_render_ns = 0;
+	uint32_t preview_renders_ps = 0;
+	uint32_t preview_saved_ps = 0;
+	double preview_time_saved = 0.0;
+	uint64_t switches = 0;
+	double switch_latency_ms = 0.0;
+	double switch_latency_p95_ms = 0.0;
 	uint32_t encoded_frames = 0;
 	uint32_t encoded_fps = 0;
 	QImage encoded_fps_graph = QImage(1, 24, QImage::Format_ARGB32);
@@ -156,12 +165,35 @@ private:
 		 }},
 		{"Canvas", "SkippedFrames", true, Qt::AlignRight | Qt::AlignVCenter, [](const OutputStatsRow &row) {
 			 return QVariant(row.skipped_frames);
+		 }},
+		{"Canvas", "PreviewRenders", false, Qt::AlignRight | Qt::AlignVCenter,
+		 [](const OutputStatsRow &row) {
+			 return QVariant(row.preview_renders_ps);
+		 }},
+		{"Canvas", "PreviewRendersSaved", false, Qt::AlignRight | Qt::AlignVCenter,
+		 [](const OutputStatsRow &row) {
+			 return QVariant(row.preview_saved_ps);
+		 }},
+		{"Canvas", "PreviewTimeSaved", false, Qt::AlignRight | Qt::AlignVCenter,
+		 [](const OutputStatsRow &row) {
+			 return QVariant(QString::number(row.preview_time_saved, 'f', 2));
+		 }},
+		{"Canvas", "SwitchLatency", false, Qt::AlignRight | Qt::AlignVCenter,
+		 [](const OutputStatsRow &row) {
+			 return row.switches ? QVariant(QString::number(row.switch_latency_ms, 'f', 1)) : QVariant();
+		 }},
+		{"Canvas", "SwitchLatencyP95", false, Qt::AlignRight | Qt::AlignVCenter, [](const OutputStatsRow &row) {
+			 return row.switches ? QVariant(QString::number(row.switch_latency_p95_ms, 'f', 1)) : QVariant();
 		 }}};
 	std::vector<OutputStatsRow> rows;
 
 	std::set<int> rows_changed;
 
 	QTimer updateTimer;
+	uint64_t last_sample_ns = 0;
+	uint64_t sample_elapsed_ns = 0;
+	uint64_t graph_elapsed_ns = 0;
+	uint64_t stats_emitted_ns = 0;
 
 	std::function<int(int)> graphWidthFunc = nullptr;
 
@@ -174,6 +206,8 @@ private:
 	static std::string encoder_name(obs_encoder_t *encoder);
 	static QColor canvas_color(obs_canvas_t *canvas);
 
+	void emitStats(uint64_t now);
+
 private slots:
 	void updateStats();
 
@@ -62,13 +62,8 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 				if (!obs_is_source_configurable(obs_source_get_id(tr))) {
 					action->setEnabled(false);
 				}
-				if (canvasDock) {
-					for (auto t : canvasDock->transitions) {
-						if (strcmp(name, obs_source_get_name(t)) == 0) {
-							action->setEnabled(false);
-							break;
-						}
-					}
+				if (canvasDock && canvasDock->transitions.Find(name)) {
+					action->setEnabled(false);
 				}
 				connect(action, &QAction::triggered, [this, tr] {
 					OBSDataAutoRelease d = obs_save_source(tr);
@@ -77,7 +72,7 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 						auto n = QString::fromUtf8(obs_source_get_name(t));
 						transition->addItem(n);
 						if (canvasDock) {
-							canvasDock->transitions.emplace_back(t);
+							canvasDock->transitions.Add(t);
 							canvasDock->transition->addItem(n);
 						}
 						transition->setCurrentText(n);
@@ -119,12 +114,7 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 						}
 						bool found = false;
 						if (canvasDock) {
-							for (auto tr : canvasDock->transitions) {
-								if (strcmp(obs_source_get_name(tr), name.c_str()) == 0) {
-									found = true;
-									break;
-								}
-							}
+							found = canvasDock->transitions.Find(name.c_str()) != nullptr;
 						} else {
 						}
 						if (found) {
@@ -137,7 +127,7 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 					auto n = QString::fromUtf8(obs_source_get_name(t));
 					transition->addItem(n);
 					if (canvasDock) {
-						canvasDock->transitions.emplace_back(t);
+						canvasDock->transitions.Add(t);
 						canvasDock->transition->addItem(n);
 					}
 					transition->setCurrentText(n);
@@ -175,14 +165,12 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 
 		auto n = transition->currentText().toUtf8();
 		if (canvasDock) {
-			for (auto it = canvasDock->transitions.begin(); it != canvasDock->transitions.end(); ++it) {
-				if (strcmp(n.constData(), obs_source_get_name(it->Get())) == 0) {
-					if (!obs_is_source_configurable(obs_source_get_id(it->Get()))) {
-						return;
-					}
-					canvasDock->transitions.erase(it);
-					break;
+			auto t = canvasDock->transitions.Find(n.constData());
+			if (t) {
+				if (!obs_is_source_configurable(obs_source_get_id(t))) {
+					return;
 				}
+				canvasDock->transitions.Remove(t);
 			}
 			for (auto idx = 0; idx < canvasDock->transition->count(); ++idx) {
 				if (canvasDock->transition->itemText(idx) == transition->currentText()) {
@@ -231,12 +219,7 @@ TransitionsDock::TransitionsDock(QWidget *parent) : QFrame(parent)
 				}
 				bool found = false;
 				if (canvasDock) {
-					for (auto tr : canvasDock->transitions) {
-						if (strcmp(obs_source_get_name(tr), name.c_str()) == 0) {
-							found = true;
-							break;
-						}
-					}
+					found = canvasDock->transitions.Find(name.c_str()) != nullptr;
 				} else {
 					struct obs_frontend_source_list frontend_transitions = {};
 					obs_frontend_get_transitions(&frontend_transitions);
@@ -319,12 +302,7 @@ obs_source_t *TransitionsDock::GetTransition(const char *transition_name)
 	}
 	obs_source_t *t = nullptr;
 	if (canvasDock) {
-		for (auto transition : canvasDock->transitions) {
-			if (strcmp(transition_name, obs_source_get_name(transition)) == 0) {
-				t = transition;
-				break;
-			}
-		}
+		t = canvasDock->transitions.Find(transition_name);
 	} else {
 		struct obs_frontend_source_list frontend_transitions = {};
 		obs_frontend_get_transitions(&frontend_transitions);
@@ -0,0 +1,84 @@
+#pragma once
+#include <map>
+#include <obs.h>
+#include <string>
+
+struct CanvasEntry {
+	obs_canvas_t *canvas = nullptr;
+	obs_weak_canvas_t *weak = nullptr;
+};
+
+// per canvas entries keyed by canvas uuid, an entry only answers for the canvas it was created for, so neither a reused
+// address nor a canvas recreated under an old uuid inherits state, T derives from CanvasEntry
+template<typename T> class CanvasMap {
+private:
+	std::map<std::string, T> entries;
+	void (*release)(T &);
+
+	void Release(T &entry)
+	{
+		if (release)
+			release(entry);
+		obs_weak_canvas_release(entry.weak);
+	}
+
+public:
+	using iterator = typename std::map<std::string, T>::iterator;
+
+	CanvasMap(void (*release_entry)(T &) = nullptr) : release(release_entry) {}
+
+	iterator begin() { return entries.begin(); }
+	iterator end() { return entries.end(); }
+
+	T &Get(obs_canvas_t *canvas)
+	{
+		auto &entry = entries[obs_canvas_get_uuid(canvas)];
+		if (entry.canvas != canvas) {
+			Release(entry);
+			entry = T();
+			entry.canvas = canvas;
+			entry.weak = obs_canvas_get_weak_canvas(canvas);
+		}
+		return entry;
+	}
+
+	T *Find(obs_canvas_t *canvas)
+	{
+		if (!canvas)
+			return nullptr;
+		auto it = entries.find(obs_canvas_get_uuid(canvas));
+		return it != entries.end() && it->second.canvas == canvas ? &it->second : nullptr;
+	}
+
+	void Remove(obs_canvas_t *canvas)
+	{
+		if (!canvas)
+			return;
+		auto it = entries.find(obs_canvas_get_uuid(canvas));
+		if (it != entries.end() && it->second.canvas == canvas)
+			Erase(it);
+	}
+
+	iterator Erase(iterator it)
+	{
+		Release(it->second);
+		return entries.erase(it);
+	}
+
+	void Clear()
+	{
+		for (auto &it : entries)
+			Release(it.second);
+		entries.clear();
+	}
+
+	// the canvas behind the entry is gone
+	static bool Expired(const T &entry)
+	{
+		auto canvas = obs_weak_canvas_get_canvas(entry.weak);
+		if (!canvas)
+			return true;
+		obs_canvas_release(canvas);
+		return false;
+	}
+};
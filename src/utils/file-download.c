@@ -1,5 +1,6 @@
 #include "file-download.h"
 #include <curl/curl.h>
+#include <inttypes.h>
 #include <obs-data.h>
 #include <util/darray.h>
 #include <util/dstr.h>
@@ -25,6 +26,16 @@
 #define warn(msg, ...) blog(LOG_WARNING, "%s" msg, info->log_prefix, ##__VA_ARGS__)
 #define info(msg, ...) blog(LOG_WARNING, "%s" msg, info->log_prefix, ##__VA_ARGS__)
 
+#define DOWNLOAD_MAX_ACTIVE 4
+#define DOWNLOAD_IDLE_WAIT_MS 1000
+
+enum download_state {
+	DOWNLOAD_QUEUED,
+	DOWNLOAD_ACTIVE,
+	DOWNLOAD_CALLBACK,
+	DOWNLOAD_DONE,
+};
+
 struct download_info {
 	char error[CURL_ERROR_SIZE];
 	struct curl_slist *header;
@@ -32,27 +43,62 @@ struct download_info {
 	char *user_agent;
 	CURL *curl;
 	char *url;
+	char *cache_file;
+	char *etag;
+	char *last_modified;
+
+	char *output_file;
+	char *output_part;
+	FILE *output;
+	download_data_callback_t data_callback;
+	download_progress_callback_t progress_callback;
+	uint64_t max_size;
+	uint64_t received;
+	bool too_large;
+
+	enum download_priority priority;
+	enum download_state state;
+	bool cancelled;
 
 	confirm_file_callback_t callback;
 	void *param;
 
-	pthread_t thread;
-	bool thread_created;
 	char *log_prefix;
 };
 
-void download_info_destroy(struct download_info *info)
+static struct {
+	pthread_mutex_t mutex;
+	pthread_t thread;
+	bool thread_created;
+	bool stopping;
+	CURLM *multi;
+	CURLSH *share;
+	DARRAY(struct download_info *) queue;
+	DARRAY(struct download_info *) active;
+} manager = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+
+static void close_output(struct download_info *info, bool keep)
 {
-	if (!info)
-		return;
-
-	if (info->thread_created)
-		pthread_join(info->thread, NULL);
+	if (info->output) {
+		fclose(info->output);
+		info->output = NULL;
+		if (!keep)
+			os_unlink(info->output_part);
+	}
+}
 
+static void free_info(struct download_info *info)
+{
+	close_output(info, false);
 	da_free(info->file_data);
 	bfree(info->log_prefix);
 	bfree(info->user_agent);
 	bfree(info->url);
+	bfree(info->cache_file);
+	bfree(info->etag);
+	bfree(info->last_modified);
+	bfree(info->output_file);
+	bfree(info->output_part);
 
 	if (info->header)
 		curl_slist_free_all(info->header);
@@ -61,100 +107,499 @@ void download_info_destroy(struct download_info *info)
 	bfree(info);
 }
 
+void download_info_destroy(struct download_info *info)
+{
+	if (!info)
+		return;
+
+	bool free_now = false;
+	pthread_mutex_lock(&manager.mutex);
+	if (info->state == DOWNLOAD_QUEUED) {
+		da_erase_item(manager.queue, &info);
+		free_now = true;
+	} else if (info->state == DOWNLOAD_DONE) {
+		free_now = true;
+	} else {
+		/* the worker owns it while it is running, it frees it at the next safe point */
+		info->cancelled = true;
+	}
+	pthread_mutex_unlock(&manager.mutex);
+
+	if (free_now)
+		free_info(info);
+	else
+		curl_multi_wakeup(manager.multi);
+}
+
 static size_t http_write(void *ptr, size_t size, size_t nmemb, void *uinfo)
 {
 	size_t total = size * nmemb;
 	struct download_info *info = (struct download_info *)uinfo;
 
-	if (total)
-		da_push_back_array(info->file_data, ptr, total);
+	if (!total)
+		return 0;
 
+	if (info->max_size && info->received + total > info->max_size) {
+		info->too_large = true;
+		return 0;
+	}
+	info->received += total;
+
+	if (info->data_callback)
+		return info->data_callback(info->param, (const uint8_t *)ptr, total) ? total : 0;
+	if (info->output)
+		return fwrite(ptr, 1, total, info->output);
+
+	da_push_back_array(info->file_data, ptr, total);
 	return total;
 }
 
-static bool do_http_request(struct download_info *info, const char *url, long *response_code)
+static int http_progress(void *uinfo, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
 {
-	CURLcode code;
-	uint8_t null_terminator = 0;
+	UNUSED_PARAMETER(ultotal);
+	UNUSED_PARAMETER(ulnow);
+	struct download_info *info = (struct download_info *)uinfo;
+
+	info->progress_callback(info->param, (uint64_t)dlnow, (uint64_t)dltotal);
+	return 0;
+}
+
+static void set_header_value(char **dst, const char *value, size_t len)
+{
+	while (len && (*value == ' ' || *value == '\t')) {
+		value++;
+		len--;
+	}
+	while (len && (value[len - 1] == '\r' || value[len - 1] == '\n' || value[len - 1] == ' '))
+		len--;
+	bfree(*dst);
+	*dst = len ? bstrdup_n(value, len) : NULL;
+}
+
+static size_t http_header(char *buffer, size_t size, size_t nitems, void *uinfo)
+{
+	size_t total = size * nitems;
+	struct download_info *info = (struct download_info *)uinfo;
+
+	if (total > 5 && astrcmpi_n(buffer, "ETag:", 5) == 0)
+		set_header_value(&info->etag, buffer + 5, total - 5);
+	else if (total > 14 && astrcmpi_n(buffer, "Last-Modified:", 14) == 0)
+		set_header_value(&info->last_modified, buffer + 14, total - 14);
+
+	return total;
+}
+
+static char *cache_meta_path(struct download_info *info)
+{
+	struct dstr path = {0};
+	dstr_printf(&path, "%s.meta", info->cache_file);
+	return path.array;
+}
+
+static bool load_cache(struct download_info *info)
+{
+	if (!info->cache_file)
+		return false;
+
+	FILE *f = os_fopen(info->cache_file, "rb");
+	if (!f)
+		return false;
+
+	int64_t size = os_fgetsize(f);
+	bool success = false;
+	if (size > 0) {
+		da_resize(info->file_data, (size_t)size);
+		success = fread(info->file_data.array, 1, (size_t)size, f) == (size_t)size;
+	}
+	fclose(f);
+	if (!success)
+		da_resize(info->file_data, 0);
+	return success;
+}
+
+static void make_parent_dirs(const char *path)
+{
+	struct dstr dir = {0};
+	dstr_copy(&dir, path);
+	char *slash = strrchr(dir.array, '/');
+	if (slash) {
+		*slash = 0;
+		os_mkdirs(dir.array);
+	}
+	dstr_free(&dir);
+}
+
+static void save_cache(struct download_info *info)
+{
+	if (!info->cache_file || !info->file_data.num)
+		return;
+
+	make_parent_dirs(info->cache_file);
+
+	if (!os_quick_write_utf8_file_safe(info->cache_file, (const char *)info->file_data.array, info->file_data.num, false,
+					   "tmp", NULL)) {
+		warn("Could not write cache file \"%s\"", info->cache_file);
+		return;
+	}
+
+	obs_data_t *meta = obs_data_create();
+	obs_data_set_string(meta, "url", info->url);
+	if (info->etag)
+		obs_data_set_string(meta, "etag", info->etag);
+	if (info->last_modified)
+		obs_data_set_string(meta, "last_modified", info->last_modified);
+	char *meta_path = cache_meta_path(info);
+	obs_data_save_json_safe(meta, meta_path, "tmp", NULL);
+	bfree(meta_path);
+	obs_data_release(meta);
+}
+
+static void add_cache_validators(struct download_info *info)
+{
+	if (!info->cache_file || !os_file_exists(info->cache_file))
+		return;
+
+	char *meta_path = cache_meta_path(info);
+	obs_data_t *meta = obs_data_create_from_json_file(meta_path);
+	bfree(meta_path);
+	if (!meta)
+		return;
+
+	struct dstr header = {0};
+	const char *etag = obs_data_get_string(meta, "etag");
+	if (etag && *etag) {
+		dstr_printf(&header, "If-None-Match: %s", etag);
+		info->header = curl_slist_append(info->header, header.array);
+	}
+	const char *last_modified = obs_data_get_string(meta, "last_modified");
+	if (last_modified && *last_modified) {
+		dstr_printf(&header, "If-Modified-Since: %s", last_modified);
+		info->header = curl_slist_append(info->header, header.array);
+	}
+	dstr_free(&header);
+	obs_data_release(meta);
+}
+
+static bool start_request(struct download_info *info)
+{
+	info->curl = curl_easy_init();
+	if (!info->curl) {
+		warn("Could not initialize Curl");
+		return false;
+	}
+
+	if (info->output_file) {
+		make_parent_dirs(info->output_file);
+		info->output = os_fopen(info->output_part, "wb");
+		if (!info->output) {
+			warn("Could not open \"%s\" for writing", info->output_part);
+			return false;
+		}
+	}
 
-	da_resize(info->file_data, 0);
-	curl_easy_setopt(info->curl, CURLOPT_URL, url);
+	add_cache_validators(info);
+
+	curl_easy_setopt(info->curl, CURLOPT_URL, info->url);
 	curl_easy_setopt(info->curl, CURLOPT_HTTPHEADER, info->header);
 	curl_easy_setopt(info->curl, CURLOPT_ERRORBUFFER, info->error);
 	curl_easy_setopt(info->curl, CURLOPT_WRITEFUNCTION, http_write);
 	curl_easy_setopt(info->curl, CURLOPT_WRITEDATA, info);
+	curl_easy_setopt(info->curl, CURLOPT_HEADERFUNCTION, http_header);
+	curl_easy_setopt(info->curl, CURLOPT_HEADERDATA, info);
+	curl_easy_setopt(info->curl, CURLOPT_PRIVATE, info);
+	curl_easy_setopt(info->curl, CURLOPT_SHARE, manager.share);
 	curl_easy_setopt(info->curl, CURLOPT_FAILONERROR, 1L);
 	curl_easy_setopt(info->curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(info->curl, CURLOPT_TCP_KEEPALIVE, 1L);
 	curl_easy_setopt(info->curl, CURLOPT_ACCEPT_ENCODING, "");
+	if (info->user_agent)
+		curl_easy_setopt(info->curl, CURLOPT_USERAGENT, info->user_agent);
+	if (info->max_size)
+		curl_easy_setopt(info->curl, CURLOPT_MAXFILESIZE_LARGE, (curl_off_t)info->max_size);
+	if (info->progress_callback) {
+		curl_easy_setopt(info->curl, CURLOPT_NOPROGRESS, 0L);
+		curl_easy_setopt(info->curl, CURLOPT_XFERINFOFUNCTION, http_progress);
+		curl_easy_setopt(info->curl, CURLOPT_XFERINFODATA, info);
+	}
 	curl_obs_set_revoke_setting(info->curl);
 
-	code = curl_easy_perform(info->curl);
-	if (code != CURLE_OK) {
-		warn("Remote update of URL \"%s\" failed: %s", url, info->error);
-		return false;
+	return curl_multi_add_handle(manager.multi, info->curl) == CURLM_OK;
+}
+
+/* called with the mutex held */
+static void start_queued(void)
+{
+	while (manager.active.num < DOWNLOAD_MAX_ACTIVE && manager.queue.num) {
+		size_t next = 0;
+		for (size_t i = 1; i < manager.queue.num; i++) {
+			if (manager.queue.array[i]->priority > manager.queue.array[next]->priority)
+				next = i;
+		}
+		struct download_info *info = manager.queue.array[next];
+		da_erase(manager.queue, next);
+
+		if (!start_request(info)) {
+			info->state = DOWNLOAD_DONE;
+			continue;
+		}
+		info->state = DOWNLOAD_ACTIVE;
+		da_push_back(manager.active, &info);
 	}
+}
 
-	if (curl_easy_getinfo(info->curl, CURLINFO_RESPONSE_CODE, response_code) != CURLE_OK)
-		return false;
+/* called with the mutex held */
+static void drop_cancelled(void)
+{
+	for (size_t i = manager.active.num; i > 0; i--) {
+		struct download_info *info = manager.active.array[i - 1];
+		if (!info->cancelled)
+			continue;
+		curl_multi_remove_handle(manager.multi, info->curl);
+		da_erase(manager.active, i - 1);
+		free_info(info);
+	}
+}
+
+static bool complete_request(struct download_info *info, CURLcode result)
+{
+	uint8_t null_terminator = 0;
+	long response_code = 0;
+
+	curl_easy_getinfo(info->curl, CURLINFO_RESPONSE_CODE, &response_code);
 
-	if (*response_code >= 400) {
-		warn("Remote update of URL \"%s\" failed: HTTP/%ld", url, *response_code);
+	if (info->too_large || result == CURLE_FILESIZE_EXCEEDED) {
+		warn("Remote update of URL \"%s\" failed: larger than %" PRIu64 " bytes", info->url, info->max_size);
+		close_output(info, false);
+		da_resize(info->file_data, 0);
 		return false;
 	}
 
-	da_push_back(info->file_data, &null_terminator);
+	if (info->output_file || info->data_callback) {
+		bool success = result == CURLE_OK && response_code < 400;
+		if (!success && result != CURLE_OK)
+			warn("Remote update of URL \"%s\" failed: %s", info->url,
+			     info->error[0] ? info->error : curl_easy_strerror(result));
+		else if (!success)
+			warn("Remote update of URL \"%s\" failed: HTTP/%ld", info->url, response_code);
+		if (!info->output)
+			return success;
+		close_output(info, success);
+		if (success && os_safe_replace(info->output_file, info->output_part, NULL) != 0) {
+			warn("Could not move \"%s\" into place", info->output_file);
+			os_unlink(info->output_part);
+			return false;
+		}
+		return success;
+	}
 
-	return true;
+	if (result == CURLE_OK && response_code == 304) {
+		if (!load_cache(info)) {
+			warn("Remote update of URL \"%s\" not modified but the cached copy is missing", info->url);
+			return false;
+		}
+	} else if (result != CURLE_OK || response_code >= 400) {
+		if (result != CURLE_OK)
+			warn("Remote update of URL \"%s\" failed: %s", info->url,
+			     info->error[0] ? info->error : curl_easy_strerror(result));
+		else
+			warn("Remote update of URL \"%s\" failed: HTTP/%ld", info->url, response_code);
+		da_resize(info->file_data, 0);
+		if (!load_cache(info))
+			return false;
+		info("Using cached copy of \"%s\"", info->url);
+	} else {
+		save_cache(info);
+	}
+
+	da_push_back(info->file_data, &null_terminator);
+	return info->file_data.array && info->file_data.array[0];
 }
 
-struct file_update_data {
-	const char *name;
-	int version;
-	bool newer;
-	bool found;
-};
+static void finish_completed(void)
+{
+	CURLMsg *msg;
+	int left;
+	while ((msg = curl_multi_info_read(manager.multi, &left))) {
+		if (msg->msg != CURLMSG_DONE)
+			continue;
+
+		CURL *easy = msg->easy_handle;
+		CURLcode result = msg->data.result;
+		struct download_info *info = NULL;
+		curl_easy_getinfo(easy, CURLINFO_PRIVATE, (char **)&info);
+		curl_multi_remove_handle(manager.multi, easy);
+
+		pthread_mutex_lock(&manager.mutex);
+		da_erase_item(manager.active, &info);
+		bool cancelled = info->cancelled;
+		if (!cancelled)
+			info->state = DOWNLOAD_CALLBACK;
+		pthread_mutex_unlock(&manager.mutex);
+
+		if (cancelled) {
+			free_info(info);
+			continue;
+		}
+
+		if (complete_request(info, result)) {
+			struct file_download_data download_data;
+			download_data.name = info->url;
+			download_data.version = 0;
+			download_data.path = info->output_file;
+			download_data.buffer.da = info->file_data.da;
+			info->callback(info->param, &download_data);
+		}
+
+		pthread_mutex_lock(&manager.mutex);
+		cancelled = info->cancelled;
+		if (!cancelled)
+			info->state = DOWNLOAD_DONE;
+		pthread_mutex_unlock(&manager.mutex);
+
+		if (cancelled)
+			free_info(info);
+	}
+}
 
-static void *single_file_thread(void *data)
+static void *download_thread(void *unused)
 {
-	struct download_info *info = data;
-	struct file_download_data download_data;
-	long response_code;
+	UNUSED_PARAMETER(unused);
+	os_set_thread_name("aitum-stream-suite-download");
 
-	info->curl = curl_easy_init();
-	if (!info->curl) {
-		warn("Could not initialize Curl");
-		return NULL;
-	}
+	pthread_mutex_lock(&manager.mutex);
+	while (!manager.stopping) {
+		start_queued();
+		pthread_mutex_unlock(&manager.mutex);
 
-	if (!do_http_request(info, info->url, &response_code))
-		return NULL;
-	if (!info->file_data.array || !info->file_data.array[0])
-		return NULL;
+		int running = 0;
+		curl_multi_perform(manager.multi, &running);
+		finish_completed();
+		curl_multi_poll(manager.multi, NULL, 0, DOWNLOAD_IDLE_WAIT_MS, NULL);
+
+		pthread_mutex_lock(&manager.mutex);
+		drop_cancelled();
+	}
 
-	download_data.name = info->url;
-	download_data.version = 0;
-	download_data.buffer.da = info->file_data.da;
-	info->callback(info->param, &download_data);
+	/* leave unfinished downloads to their owners, they still call download_info_destroy */
+	for (size_t i = 0; i < manager.active.num; i++) {
+		struct download_info *info = manager.active.array[i];
+		curl_multi_remove_handle(manager.multi, info->curl);
+		if (info->cancelled) {
+			free_info(info);
+			continue;
+		}
+		curl_easy_cleanup(info->curl);
+		info->curl = NULL;
+		info->state = DOWNLOAD_DONE;
+	}
+	da_free(manager.active);
+	for (size_t i = 0; i < manager.queue.num; i++)
+		manager.queue.array[i]->state = DOWNLOAD_DONE;
+	da_free(manager.queue);
+	pthread_mutex_unlock(&manager.mutex);
 	return NULL;
 }
 
-download_info_t *download_info_create_single(const char *log_prefix, const char *user_agent, const char *file_url,
-					 confirm_file_callback_t confirm_callback, void *param)
+/* called with the mutex held */
+static bool start_manager(void)
+{
+	if (manager.thread_created)
+		return true;
+
+	manager.multi = curl_multi_init();
+	manager.share = curl_share_init();
+	if (!manager.multi || !manager.share) {
+		blog(LOG_WARNING, "[Aitum Stream Suite] Could not initialize Curl");
+		curl_multi_cleanup(manager.multi);
+		curl_share_cleanup(manager.share);
+		manager.multi = NULL;
+		manager.share = NULL;
+		return false;
+	}
+	curl_share_setopt(manager.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	curl_share_setopt(manager.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+	if (pthread_create(&manager.thread, NULL, download_thread, NULL) != 0) {
+		curl_multi_cleanup(manager.multi);
+		curl_share_cleanup(manager.share);
+		manager.multi = NULL;
+		manager.share = NULL;
+		return false;
+	}
+	manager.thread_created = true;
+	return true;
+}
+
+void download_manager_shutdown(void)
+{
+	pthread_mutex_lock(&manager.mutex);
+	if (!manager.thread_created) {
+		pthread_mutex_unlock(&manager.mutex);
+		return;
+	}
+	manager.stopping = true;
+	pthread_mutex_unlock(&manager.mutex);
+
+	curl_multi_wakeup(manager.multi);
+	pthread_join(manager.thread, NULL);
+
+	curl_multi_cleanup(manager.multi);
+	curl_share_cleanup(manager.share);
+	manager.multi = NULL;
+	manager.share = NULL;
+	manager.thread_created = false;
+	manager.stopping = false;
+}
+
+download_info_t *download_info_create(const struct download_options *options, confirm_file_callback_t confirm_callback,
+				      void *param)
 {
 	struct download_info *info;
 
-	if (!log_prefix)
-		log_prefix = "";
+	if (!options || !options->url)
+		return NULL;
 
 	info = bzalloc(sizeof(*info));
-	info->log_prefix = bstrdup(log_prefix);
-	info->user_agent = bstrdup(user_agent);
-	info->url = bstrdup(file_url);
+	info->log_prefix = bstrdup(options->log_prefix ? options->log_prefix : "");
+	info->user_agent = bstrdup(options->user_agent);
+	info->url = bstrdup(options->url);
+	info->priority = options->priority;
+	info->max_size = options->max_size;
+	info->data_callback = options->data_callback;
+	info->progress_callback = options->progress_callback;
+	if (options->output_file) {
+		info->output_file = bstrdup(options->output_file);
+		struct dstr part = {0};
+		dstr_printf(&part, "%s.part", options->output_file);
+		info->output_part = part.array;
+	}
+	/* streamed bodies never reach the buffer, so there is nothing to revalidate against */
+	if (!options->output_file && !options->data_callback)
+		info->cache_file = bstrdup(options->cache_file);
 	info->callback = confirm_callback;
 	info->param = param;
+	info->state = DOWNLOAD_QUEUED;
 
-	if (pthread_create(&info->thread, NULL, single_file_thread, info) == 0)
-		info->thread_created = true;
+	pthread_mutex_lock(&manager.mutex);
+	if (manager.stopping || !start_manager()) {
+		info->state = DOWNLOAD_DONE;
+		pthread_mutex_unlock(&manager.mutex);
+		return info;
+	}
+	da_push_back(manager.queue, &info);
+	pthread_mutex_unlock(&manager.mutex);
 
+	curl_multi_wakeup(manager.multi);
 	return info;
 }
+
+download_info_t *download_info_create_single(const char *log_prefix, const char *user_agent, const char *file_url,
+					 confirm_file_callback_t confirm_callback, void *param)
+{
+	struct download_options options = {0};
+	options.log_prefix = log_prefix;
+	options.user_agent = user_agent;
+	options.url = file_url;
+	options.priority = DOWNLOAD_PRIORITY_NORMAL;
+	return download_info_create(&options, confirm_callback, param);
+}
@@ -12,16 +12,51 @@ typedef struct download_info download_info_t;
 struct file_download_data {
 	const char *name;
 	int version;
+	/* set when the download was written to a file, the buffer is empty then */
+	const char *path;
 
 	DARRAY(uint8_t) buffer;
 };
 
 typedef bool (*confirm_file_callback_t)(void *param, struct file_download_data *file);
+/* receives the body as it arrives, return false to abort */
+typedef bool (*download_data_callback_t)(void *param, const uint8_t *data, size_t size);
+/* total is 0 while the size is unknown */
+typedef void (*download_progress_callback_t)(void *param, uint64_t received, uint64_t total);
+
+enum download_priority {
+	DOWNLOAD_PRIORITY_LOW,
+	DOWNLOAD_PRIORITY_NORMAL,
+	DOWNLOAD_PRIORITY_HIGH,
+};
+
+struct download_options {
+	const char *log_prefix;
+	const char *user_agent;
+	const char *url;
+	enum download_priority priority;
+	/* full path of the cached copy, revalidated with ETag/If-Modified-Since and used when offline, NULL to disable */
+	const char *cache_file;
+	/* stream the body to this file instead of memory, written next to it and moved in place when complete */
+	const char *output_file;
+	/* stream the body to this callback instead of memory, no cache is used then */
+	download_data_callback_t data_callback;
+	download_progress_callback_t progress_callback;
+	/* abort when the body grows past this many bytes, 0 for no limit */
+	uint64_t max_size;
+};
 
+/* all downloads share one worker thread and curl multi handle, so connections, DNS and TLS sessions are reused */
+download_info_t *download_info_create(const struct download_options *options, confirm_file_callback_t confirm_callback,
+				      void *param);
 download_info_t *download_info_create_single(const char *log_prefix, const char *user_agent, const char *file_url,
 					 confirm_file_callback_t confirm_callback, void *param);
+/* cancels the download if it is still queued or running, safe to call from inside the callback */
 void download_info_destroy(download_info_t *info);
 
+/* stops the worker thread, call after destroying the outstanding downloads */
+void download_manager_shutdown(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,284 @@
+#include "hotkey-dispatch.hpp"
+#include "../docks/canvas-dock.hpp"
+#include "switch-latency.hpp"
+#include "widgets/output-widget.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <obs-frontend-api.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct HotkeyTarget {
+	HotkeyAction action;
+	CanvasDock *dock = nullptr;
+	OutputWidget *output = nullptr;
+	OBSWeakSource scene;
+	std::string scene_uuid;
+};
+
+using HotkeyTargetPtr = std::unique_ptr<HotkeyTarget>;
+using HotkeyTargetPair = std::pair<HotkeyTargetPtr, HotkeyTargetPtr>;
+
+static std::mutex dispatch_mutex;
+static std::unordered_map<obs_hotkey_id, HotkeyTargetPtr> dispatch_table;
+// select scene hotkeys by scene uuid, one per dock showing the scene
+static std::unordered_map<std::string, std::vector<obs_hotkey_id>> dispatch_scenes;
+// pairs do not expose the ids of their halves, so both targets are kept under the pair id
+static std::unordered_map<obs_hotkey_pair_id, HotkeyTargetPair> dispatch_pairs;
+
+static void select_scene_pressed(void *data, obs_hotkey_id, obs_hotkey_t *, bool pressed)
+{
+	if (!pressed) {
+		return;
+	}
+	auto target = (HotkeyTarget *)data;
+	OBSSourceAutoRelease scene = obs_weak_source_get_source(target->scene);
+	if (!scene) {
+		return;
+	}
+	auto dock = target->dock;
+	switch_latency_request(dock->GetCanvas(), "hotkey");
+	QMetaObject::invokeMethod(dock, [dock, s = OBSSource(scene.Get())] { dock->SwitchToScene(s, true); });
+}
+
+static void output_pressed(void *data, obs_hotkey_id, obs_hotkey_t *, bool pressed)
+{
+	if (!pressed) {
+		return;
+	}
+	auto target = (HotkeyTarget *)data;
+	target->output->TriggerHotkey(target->action);
+}
+
+static bool output_pair_pressed(void *data, obs_hotkey_pair_id, obs_hotkey_t *, bool pressed)
+{
+	if (!pressed) {
+		return false;
+	}
+	auto target = (HotkeyTarget *)data;
+	return target->output->TriggerHotkey(target->action);
+}
+
+// call with dispatch_mutex held
+static HotkeyTargetPtr take_target(obs_hotkey_id id)
+{
+	auto it = dispatch_table.find(id);
+	if (it == dispatch_table.end()) {
+		return nullptr;
+	}
+	auto target = std::move(it->second);
+	dispatch_table.erase(it);
+	if (target->action != HotkeyAction::SelectScene) {
+		return target;
+	}
+	auto s = dispatch_scenes.find(target->scene_uuid);
+	if (s != dispatch_scenes.end()) {
+		s->second.erase(std::remove(s->second.begin(), s->second.end(), id), s->second.end());
+		if (s->second.empty()) {
+			dispatch_scenes.erase(s);
+		}
+	}
+	return target;
+}
+
+static void scene_destroyed(void *, calldata_t *calldata);
+
+// unregistering waits for a running press, after that the targets can go
+static void unregister_targets(std::vector<std::pair<obs_hotkey_id, HotkeyTargetPtr>> &removed)
+{
+	for (auto &it : removed) {
+		obs_hotkey_unregister(it.first);
+		if (it.second->action != HotkeyAction::SelectScene) {
+			continue;
+		}
+		OBSSourceAutoRelease scene = obs_weak_source_get_source(it.second->scene);
+		if (!scene) {
+			continue;
+		}
+		bool registered;
+		{
+			std::lock_guard<std::mutex> lock(dispatch_mutex);
+			registered = dispatch_scenes.find(it.second->scene_uuid) != dispatch_scenes.end();
+		}
+		if (!registered) {
+			signal_handler_disconnect(obs_source_get_signal_handler(scene), "destroy", scene_destroyed, nullptr);
+		}
+	}
+}
+
+template<typename F> static void remove_targets(F matches)
+{
+	std::vector<std::pair<obs_hotkey_id, HotkeyTargetPtr>> removed;
+	std::vector<std::pair<obs_hotkey_pair_id, HotkeyTargetPair>> removed_pairs;
+	{
+		std::lock_guard<std::mutex> lock(dispatch_mutex);
+		std::vector<obs_hotkey_id> ids;
+		for (const auto &it : dispatch_table) {
+			if (matches(*it.second)) {
+				ids.push_back(it.first);
+			}
+		}
+		for (auto id : ids) {
+			removed.emplace_back(id, take_target(id));
+		}
+		for (auto it = dispatch_pairs.begin(); it != dispatch_pairs.end();) {
+			if (matches(*it->second.first)) {
+				removed_pairs.emplace_back(it->first, std::move(it->second));
+				it = dispatch_pairs.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+	unregister_targets(removed);
+	for (auto &it : removed_pairs) {
+		obs_hotkey_pair_unregister(it.first);
+	}
+}
+
+// drops the select scene hotkeys of this scene only, a scene recreated under the same uuid keeps its own
+static void remove_scene_targets(obs_source_t *scene)
+{
+	std::vector<std::pair<obs_hotkey_id, HotkeyTargetPtr>> removed;
+	{
+		std::lock_guard<std::mutex> lock(dispatch_mutex);
+		auto it = dispatch_scenes.find(obs_source_get_uuid(scene));
+		if (it == dispatch_scenes.end()) {
+			return;
+		}
+		std::vector<obs_hotkey_id> ids;
+		for (auto id : it->second) {
+			if (obs_weak_source_references_source(dispatch_table[id]->scene, scene)) {
+				ids.push_back(id);
+			}
+		}
+		for (auto id : ids) {
+			removed.emplace_back(id, take_target(id));
+		}
+	}
+	unregister_targets(removed);
+}
+
+static void remove_target(obs_hotkey_id id)
+{
+	std::vector<std::pair<obs_hotkey_id, HotkeyTargetPtr>> removed;
+	{
+		std::lock_guard<std::mutex> lock(dispatch_mutex);
+		auto target = take_target(id);
+		if (!target) {
+			return;
+		}
+		removed.emplace_back(id, std::move(target));
+	}
+	unregister_targets(removed);
+}
+
+static void scene_destroyed(void *, calldata_t *calldata)
+{
+	auto scene = (obs_source_t *)calldata_ptr(calldata, "source");
+	if (scene) {
+		remove_scene_targets(scene);
+	}
+}
+
+void hotkey_dispatch_add_scene(CanvasDock *dock, obs_source_t *scene)
+{
+	if (!dock || !scene) {
+		return;
+	}
+	const char *uuid = obs_source_get_uuid(scene);
+	obs_hotkey_id stale = OBS_INVALID_HOTKEY_ID;
+	{
+		std::lock_guard<std::mutex> lock(dispatch_mutex);
+		auto it = dispatch_scenes.find(uuid);
+		if (it != dispatch_scenes.end()) {
+			for (auto id : it->second) {
+				const auto &target = dispatch_table[id];
+				if (target->dock != dock) {
+					continue;
+				}
+				if (obs_weak_source_references_source(target->scene, scene)) {
+					return;
+				}
+				stale = id;
+				break;
+			}
+		}
+	}
+	if (stale != OBS_INVALID_HOTKEY_ID) {
+		// the uuid belongs to a destroyed scene that has been recreated
+		remove_target(stale);
+	}
+
+	auto target = std::make_unique<HotkeyTarget>();
+	target->action = HotkeyAction::SelectScene;
+	target->dock = dock;
+	target->scene = OBSGetWeakRef(scene);
+	target->scene_uuid = uuid;
+
+	std::string description = obs_canvas_get_name(dock->GetCanvas());
+	description += " ";
+	description += obs_frontend_get_locale_string("Basic.Hotkeys.SelectScene");
+	auto id = obs_hotkey_register_source(scene, "OBSBasic.SelectScene", description.c_str(), select_scene_pressed,
+					     target.get());
+	if (id == OBS_INVALID_HOTKEY_ID) {
+		return;
+	}
+	signal_handler_connect(obs_source_get_signal_handler(scene), "destroy", scene_destroyed, nullptr);
+	std::lock_guard<std::mutex> lock(dispatch_mutex);
+	dispatch_table.emplace(id, std::move(target));
+	dispatch_scenes[uuid].push_back(id);
+}
+
+void hotkey_dispatch_remove_scene(obs_source_t *scene)
+{
+	if (!scene) {
+		return;
+	}
+	remove_scene_targets(scene);
+}
+
+void hotkey_dispatch_remove_canvas(CanvasDock *dock)
+{
+	remove_targets([dock](const HotkeyTarget &target) { return target.dock == dock; });
+}
+
+obs_hotkey_id hotkey_dispatch_add_output(OutputWidget *widget, HotkeyAction action, const char *name, const char *description)
+{
+	auto target = std::make_unique<HotkeyTarget>();
+	target->action = action;
+	target->output = widget;
+	auto id = obs_hotkey_register_frontend(name, description, output_pressed, target.get());
+	if (id == OBS_INVALID_HOTKEY_ID) {
+		return id;
+	}
+	std::lock_guard<std::mutex> lock(dispatch_mutex);
+	dispatch_table.emplace(id, std::move(target));
+	return id;
+}
+
+obs_hotkey_pair_id hotkey_dispatch_add_output_pair(OutputWidget *widget, const char *start_name, const char *start_description,
+						   const char *stop_name, const char *stop_description)
+{
+	auto start = std::make_unique<HotkeyTarget>();
+	start->action = HotkeyAction::StartOutput;
+	start->output = widget;
+	auto stop = std::make_unique<HotkeyTarget>();
+	stop->action = HotkeyAction::StopOutput;
+	stop->output = widget;
+	auto id = obs_hotkey_pair_register_frontend(start_name, start_description, stop_name, stop_description,
+						   output_pair_pressed, output_pair_pressed, start.get(), stop.get());
+	if (id == OBS_INVALID_HOTKEY_PAIR_ID) {
+		return id;
+	}
+	std::lock_guard<std::mutex> lock(dispatch_mutex);
+	dispatch_pairs.emplace(id, HotkeyTargetPair(std::move(start), std::move(stop)));
+	return id;
+}
+
+void hotkey_dispatch_remove_output(OutputWidget *widget)
+{
+	remove_targets([widget](const HotkeyTarget &target) { return target.output == widget; });
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <obs.h>
+
+class CanvasDock;
+class OutputWidget;
+
+enum class HotkeyAction {
+	SelectScene,
+	StartOutput,
+	StopOutput,
+	SaveBacktrack,
+};
+
+// select scene and output hotkeys keyed by hotkey id, each hotkey carries its own target so a press needs no lookup or lock
+void hotkey_dispatch_add_scene(CanvasDock *dock, obs_source_t *scene);
+void hotkey_dispatch_remove_scene(obs_source_t *scene);
+void hotkey_dispatch_remove_canvas(CanvasDock *dock);
+
+obs_hotkey_id hotkey_dispatch_add_output(OutputWidget *widget, HotkeyAction action, const char *name, const char *description);
+obs_hotkey_pair_id hotkey_dispatch_add_output_pair(OutputWidget *widget, const char *start_name, const char *start_description,
+						   const char *stop_name, const char *stop_description);
+void hotkey_dispatch_remove_output(OutputWidget *widget);
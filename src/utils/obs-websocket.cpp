@@ -6,10 +6,19 @@
 #include "../docks/output-dock.hpp"
 #include "../version.h"
 #include "obs-websocket-api.h"
+#include "registry.hpp"
+#include "scene-links.hpp"
+#include "switch-latency.hpp"
+#include "vendor-events.hpp"
+#include <atomic>
 #include <list>
+#include <map>
+#include <mutex>
+#include <string>
 #include <QDockWidget>
 #include <QMainWindow>
 #include <QTabBar>
+#include <util/platform.h>
 
 obs_websocket_vendor vendor = nullptr;
 extern std::list<CanvasDock *> canvas_docks;
@@ -18,6 +27,131 @@ extern OutputDock *output_dock;
 extern LiveScenesDock *live_scenes_dock;
 extern QTabBar *modesTabBar;
 
+// subscriptions are leases, a client that disconnects without unsubscribing stops counting once its lease runs out
+struct vendor_subscription {
+	uint32_t value;
+	uint64_t expires;
+};
+
+static std::mutex vendor_subscriptions_mutex;
+static std::map<std::string, vendor_subscription> vendor_subscriptions;
+static std::atomic<uint32_t> vendor_subscribed_events = VENDOR_EVENT_DEFAULT;
+static std::map<std::string, vendor_subscription> vendor_stats_subscriptions;
+static std::atomic<uint32_t> vendor_stats_interval_ms = 0;
+static std::atomic<uint64_t> vendor_subscriptions_expire = 0;
+
+static void vendor_expire_subscriptions();
+
+static const struct {
+	const char *name;
+	uint32_t category;
+} vendor_event_categories[] = {
+	{"scenes", VENDOR_EVENT_SCENES},
+	{"scene_items", VENDOR_EVENT_SCENE_ITEMS},
+	{"outputs", VENDOR_EVENT_OUTPUTS},
+	{"canvas", VENDOR_EVENT_CANVAS},
+	{"docks", VENDOR_EVENT_DOCKS},
+};
+
+bool vendor_event_wanted(uint32_t category)
+{
+	if (!vendor)
+		return false;
+	vendor_expire_subscriptions();
+	return (vendor_subscribed_events & category) != 0;
+}
+
+uint32_t vendor_stats_interval()
+{
+	if (!vendor)
+		return 0;
+	vendor_expire_subscriptions();
+	return vendor_stats_interval_ms.load();
+}
+
+void vendor_emit_event(uint32_t category, const char *event_name, obs_data_t *data)
+{
+	if (!vendor_event_wanted(category))
+		return;
+	obs_websocket_vendor_emit_event(vendor, event_name, data);
+}
+
+// call with vendor_subscriptions_mutex held
+static void vendor_update_subscribed_events()
+{
+	const uint64_t now = os_gettime_ns();
+	uint64_t expire = 0;
+	uint32_t events = VENDOR_EVENT_DEFAULT;
+	for (auto it = vendor_subscriptions.begin(); it != vendor_subscriptions.end();) {
+		if (it->second.expires <= now) {
+			it = vendor_subscriptions.erase(it);
+			continue;
+		}
+		events |= it->second.value;
+		if (!expire || it->second.expires < expire)
+			expire = it->second.expires;
+		++it;
+	}
+	uint32_t interval = 0;
+	for (auto it = vendor_stats_subscriptions.begin(); it != vendor_stats_subscriptions.end();) {
+		if (it->second.expires <= now) {
+			it = vendor_stats_subscriptions.erase(it);
+			continue;
+		}
+		if (!interval || it->second.value < interval)
+			interval = it->second.value;
+		if (!expire || it->second.expires < expire)
+			expire = it->second.expires;
+		++it;
+	}
+	if (interval)
+		events |= VENDOR_EVENT_STATS;
+	vendor_stats_interval_ms = interval;
+	vendor_subscribed_events = events;
+	vendor_subscriptions_expire = expire;
+}
+
+static void vendor_expire_subscriptions()
+{
+	const uint64_t expire = vendor_subscriptions_expire;
+	if (!expire || os_gettime_ns() < expire)
+		return;
+	std::lock_guard<std::mutex> lock(vendor_subscriptions_mutex);
+	vendor_update_subscribed_events();
+}
+
+// reads the optional ttl_ms of a subscribe request, false when it is invalid
+static bool vendor_subscription_expires(obs_data_t *request_data, obs_data_t *response_data, uint64_t *expires)
+{
+	auto ttl = obs_data_get_int(request_data, "ttl_ms");
+	if (ttl < 0) {
+		obs_data_set_string(response_data, "error", "'ttl_ms' invalid");
+		obs_data_set_bool(response_data, "success", false);
+		return false;
+	}
+	if (!ttl)
+		ttl = VENDOR_SUBSCRIPTION_TTL_MS;
+	else if (ttl > VENDOR_SUBSCRIPTION_TTL_MAX_MS)
+		ttl = VENDOR_SUBSCRIPTION_TTL_MAX_MS;
+	*expires = os_gettime_ns() + (uint64_t)ttl * 1000000;
+	obs_data_set_int(response_data, "ttl_ms", ttl);
+	return true;
+}
+
+static obs_data_array_t *vendor_events_array(uint32_t events)
+{
+	auto ea = obs_data_array_create();
+	for (const auto &c : vendor_event_categories) {
+		if (!(events & c.category))
+			continue;
+		auto e = obs_data_create();
+		obs_data_set_string(e, "name", c.name);
+		obs_data_array_push_back(ea, e);
+		obs_data_release(e);
+	}
+	return ea;
+}
+
 void vendor_request_version(obs_data_t *request_data, obs_data_t *response_data, void *)
 {
 	UNUSED_PARAMETER(request_data);
@@ -25,33 +159,86 @@ void vendor_request_version(obs_data_t *request_data, obs_data_t *response_data,
 	obs_data_set_bool(response_data, "success", true);
 }
 
+static obs_data_t *canvas_data(obs_canvas_t *canvas, const char *type)
+{
+	auto c = obs_data_create();
+	obs_data_set_string(c, "type", type);
+	obs_data_set_string(c, "name", obs_canvas_get_name(canvas));
+	obs_data_set_string(c, "uuid", obs_canvas_get_uuid(canvas));
+	obs_video_info ovi;
+	if (obs_canvas_get_video_info(canvas, &ovi)) {
+		obs_data_set_int(c, "width", ovi.base_width);
+		obs_data_set_int(c, "height", ovi.base_height);
+	}
+	return c;
+}
+
+static void canvas_set_current_scene(obs_canvas_t *canvas, obs_data_t *data)
+{
+	auto source = obs_canvas_get_channel(canvas, 0);
+	if (source && obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION) {
+		obs_source_release(source);
+		source = obs_transition_get_active_source(source);
+	}
+	if (source) {
+		obs_data_set_string(data, "scene", obs_source_get_name(source));
+		obs_data_set_string(data, "scene_uuid", obs_source_get_uuid(source));
+		obs_source_release(source);
+	} else {
+		obs_data_set_string(data, "scene", "");
+		obs_data_set_string(data, "scene_uuid", "");
+	}
+}
+
+static obs_data_array_t *canvas_scenes_array(obs_canvas_t *canvas)
+{
+	auto sa = obs_data_array_create();
+	obs_canvas_enum_scenes(
+		canvas,
+		[](void *param, obs_source_t *scene) {
+			auto a = (obs_data_array_t *)param;
+			auto s = obs_data_create();
+			obs_data_set_string(s, "name", obs_source_get_name(scene));
+			obs_data_set_string(s, "uuid", obs_source_get_uuid(scene));
+			obs_data_array_push_back(a, s);
+			obs_data_release(s);
+			return true;
+		},
+		sa);
+	return sa;
+}
+
+static obs_data_array_t *canvas_transitions_array(CanvasDock *dock)
+{
+	auto ta = obs_data_array_create();
+	auto transitions = dock->GetTransitions();
+	for (const auto &t : transitions) {
+		auto tr = obs_data_create();
+		obs_data_set_string(tr, "name", obs_source_get_name(t));
+		obs_data_set_string(tr, "uuid", obs_source_get_uuid(t));
+		obs_data_set_string(tr, "type", obs_source_get_id(t));
+		auto settings = obs_source_get_settings(t);
+		if (settings) {
+			obs_data_set_obj(tr, "settings", settings);
+			obs_data_release(settings);
+		}
+		obs_data_array_push_back(ta, tr);
+		obs_data_release(tr);
+	}
+	return ta;
+}
+
 void vendor_request_get_canvas(obs_data_t *request_data, obs_data_t *response_data, void *)
 {
 	UNUSED_PARAMETER(request_data);
 	auto ca = obs_data_array_create();
 	for (const auto &it : canvas_docks) {
-		auto c = obs_data_create();
-		obs_data_set_string(c, "type", "extra");
-		obs_data_set_string(c, "name", obs_canvas_get_name(it->GetCanvas()));
-		obs_data_set_string(c, "uuid", obs_canvas_get_uuid(it->GetCanvas()));
-		obs_video_info ovi;
-		if (obs_canvas_get_video_info(it->GetCanvas(), &ovi)) {
-			obs_data_set_int(c, "width", ovi.base_width);
-			obs_data_set_int(c, "height", ovi.base_height);
-		}
+		auto c = canvas_data(it->GetCanvas(), "extra");
 		obs_data_array_push_back(ca, c);
 		obs_data_release(c);
 	}
 	for (const auto &it : canvas_clone_docks) {
-		auto c = obs_data_create();
-		obs_data_set_string(c, "type", "clone");
-		obs_data_set_string(c, "name", obs_canvas_get_name(it->GetCanvas()));
-		obs_data_set_string(c, "uuid", obs_canvas_get_uuid(it->GetCanvas()));
-		obs_video_info ovi;
-		if (obs_canvas_get_video_info(it->GetCanvas(), &ovi)) {
-			obs_data_set_int(c, "width", ovi.base_width);
-			obs_data_set_int(c, "height", ovi.base_height);
-		}
+		auto c = canvas_data(it->GetCanvas(), "clone");
 		obs_data_array_push_back(ca, c);
 		obs_data_release(c);
 	}
@@ -69,9 +256,15 @@ void vendor_request_switch_scene(obs_data_t *request_data, obs_data_t *response_
 		return;
 	}
 	const char *canvas_name = obs_data_get_string(request_data, "canvas");
-	for (const auto &it : canvas_docks) {
-		if (canvas_name[0] == '\0' || strcmp(obs_canvas_get_name(it->GetCanvas()), canvas_name) == 0 ||
-		    strcmp(obs_canvas_get_uuid(it->GetCanvas()), canvas_name) == 0) {
+	if (canvas_name[0] != '\0') {
+		auto cd = registry_find_canvas_dock(canvas_name);
+		if (cd) {
+			switch_latency_request(cd->GetCanvas(), "websocket");
+			QMetaObject::invokeMethod(cd, "SwitchScene", Q_ARG(QString, QString::fromUtf8(scene_name)));
+		}
+	} else {
+		for (const auto &it : canvas_docks) {
+			switch_latency_request(it->GetCanvas(), "websocket");
 			QMetaObject::invokeMethod(it, "SwitchScene", Q_ARG(QString, QString::fromUtf8(scene_name)));
 		}
 	}
@@ -87,26 +280,11 @@ void vendor_request_current_scene(obs_data_t *request_data, obs_data_t *response
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		auto canvas = cd->GetCanvas();
 
-		auto source = obs_canvas_get_channel(canvas, 0);
-		if (source && obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION) {
-			obs_source_release(source);
-			source = obs_transition_get_active_source(source);
-		}
-		if (source) {
-			obs_data_set_string(response_data, "scene", obs_source_get_name(source));
-			obs_data_set_string(response_data, "scene_uuid", obs_source_get_uuid(source));
-			obs_source_release(source);
-		} else {
-			obs_data_set_string(response_data, "scene", "");
-			obs_data_set_string(response_data, "scene_uuid", "");
-		}
+		canvas_set_current_scene(canvas, response_data);
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -122,26 +300,11 @@ void vendor_request_get_scenes(obs_data_t *request_data, obs_data_t *response_da
 		return;
 	}
 
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		auto canvas = cd->GetCanvas();
 
-		auto sa = obs_data_array_create();
-		obs_canvas_enum_scenes(
-			canvas,
-			[](void *param, obs_source_t *scene) {
-				auto a = (obs_data_array_t *)param;
-				auto s = obs_data_create();
-				obs_data_set_string(s, "name", obs_source_get_name(scene));
-				obs_data_set_string(s, "uuid", obs_source_get_uuid(scene));
-				obs_data_array_push_back(a, s);
-				obs_data_release(s);
-				return true;
-			},
-			sa);
+		auto sa = canvas_scenes_array(canvas);
 		obs_data_set_bool(response_data, "success", true);
 		obs_data_set_array(response_data, "scenes", sa);
 		obs_data_array_release(sa);
@@ -151,6 +314,105 @@ void vendor_request_get_scenes(obs_data_t *request_data, obs_data_t *response_da
 	obs_data_set_bool(response_data, "success", false);
 }
 
+struct vendor_linked_scenes {
+	obs_data_t *response_data;
+	std::string canvas_name;
+	uint32_t width;
+	uint32_t height;
+};
+
+void vendor_request_get_linked_scenes(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	vendor_linked_scenes ls = {response_data, "", 0, 0};
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (canvas_name[0] != '\0') {
+		auto cd = registry_find_canvas_dock(canvas_name);
+		if (!cd) {
+			obs_data_set_string(response_data, "error", "'canvas' not found");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+		ls.canvas_name = obs_canvas_get_name(cd->GetCanvas());
+		ls.width = cd->GetCanvasWidth();
+		ls.height = cd->GetCanvasHeight();
+	}
+	// a stale link graph is rebuilt from the frontend scene list, which has to happen on the ui thread
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto ls = static_cast<vendor_linked_scenes *>(param);
+			scene_links_adopt(ls->canvas_name.c_str(), ls->width, ls->height);
+			auto la = scene_links_array(ls->canvas_name.c_str());
+			obs_data_set_array(ls->response_data, "links", la);
+			obs_data_array_release(la);
+		},
+		&ls, true);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+static obs_data_t *switch_latency_data(obs_canvas_t *canvas)
+{
+	struct switch_latency_stats sls = {};
+	switch_latency_get_stats(canvas, &sls);
+	auto d = obs_data_create();
+	obs_data_set_string(d, "canvas", obs_canvas_get_name(canvas));
+	obs_data_set_int(d, "switches", (long long)sls.switches);
+	obs_data_set_double(d, "last_ms", (double)sls.last_ns / 1000000.0);
+	obs_data_set_double(d, "avg_ms", sls.switches ? (double)sls.total_ns / (double)sls.switches / 1000000.0 : 0.0);
+	obs_data_set_double(d, "max_ms", (double)sls.max_ns / 1000000.0);
+	obs_data_set_double(d, "p50_ms", switch_latency_percentile_ms(&sls, 0.5));
+	obs_data_set_double(d, "p95_ms", switch_latency_percentile_ms(&sls, 0.95));
+	obs_data_set_int(d, "last_frames", (long long)sls.last_frames);
+	obs_data_set_string(d, "last_origin", sls.last_origin ? sls.last_origin : "");
+	obs_data_set_int(d, "transitions", (long long)sls.transitions);
+	obs_data_set_double(d, "last_transition_ms", (double)sls.last_transition_ns / 1000000.0);
+	obs_data_set_int(d, "last_transition_frames", (long long)sls.last_transition_frames);
+	auto ha = obs_data_array_create();
+	for (size_t i = 0; i < SWITCH_LATENCY_BUCKETS; i++) {
+		auto b = obs_data_create();
+		if (switch_latency_bucket_ms[i])
+			obs_data_set_int(b, "below_ms", switch_latency_bucket_ms[i]);
+		obs_data_set_int(b, "count", (long long)sls.buckets[i]);
+		obs_data_array_push_back(ha, b);
+		obs_data_release(b);
+	}
+	obs_data_set_array(d, "histogram", ha);
+	obs_data_array_release(ha);
+	return d;
+}
+
+void vendor_request_get_switch_latency(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	const bool reset = obs_data_get_bool(request_data, "reset");
+	auto la = obs_data_array_create();
+	if (canvas_name[0] != '\0') {
+		auto cd = registry_find_canvas_dock(canvas_name);
+		if (!cd) {
+			obs_data_array_release(la);
+			obs_data_set_string(response_data, "error", "'canvas' not found");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+		auto d = switch_latency_data(cd->GetCanvas());
+		obs_data_array_push_back(la, d);
+		obs_data_release(d);
+		if (reset)
+			switch_latency_reset(cd->GetCanvas());
+	} else {
+		for (const auto &it : canvas_docks) {
+			auto d = switch_latency_data(it->GetCanvas());
+			obs_data_array_push_back(la, d);
+			obs_data_release(d);
+		}
+		if (reset)
+			switch_latency_reset(nullptr);
+	}
+	obs_data_set_array(response_data, "canvas", la);
+	obs_data_array_release(la);
+	obs_data_set_bool(response_data, "success", true);
+}
+
 void vendor_request_get_outputs(obs_data_t *request_data, obs_data_t *response_data, void *)
 {
 	UNUSED_PARAMETER(request_data);
@@ -174,29 +436,9 @@ void vendor_request_start_output(obs_data_t *request_data, obs_data_t *response_
 		return;
 	}
 
-	std::string startName = "AitumStreamSuiteStartOutput";
-	startName += output_name;
-
-	struct find_hotkey {
-		obs_hotkey_t *hotkey;
-		const char *name;
-	};
-	find_hotkey t = {};
-	t.name = startName.c_str();
-	obs_enum_hotkeys(
-		[](void *param, obs_hotkey_id id, obs_hotkey_t *key) {
-			UNUSED_PARAMETER(id);
-			const auto hp = (struct find_hotkey *)param;
-			const auto hn = obs_hotkey_get_name(key);
-			if (strcmp(hp->name, hn) == 0) {
-				hp->hotkey = key;
-			}
-			return true;
-		},
-		&t);
-	if (t.hotkey) {
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), true);
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), false);
+	auto widget = registry_find_output(output_name);
+	if (widget) {
+		widget->TriggerHotkey(HotkeyAction::StartOutput);
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -213,29 +455,9 @@ void vendor_request_stop_output(obs_data_t *request_data, obs_data_t *response_d
 		return;
 	}
 
-	std::string stopName = "AitumStreamSuiteStopOutput";
-	stopName += output_name;
-
-	struct find_hotkey {
-		obs_hotkey_t *hotkey;
-		const char *name;
-	};
-	find_hotkey t = {};
-	t.name = stopName.c_str();
-	obs_enum_hotkeys(
-		[](void *param, obs_hotkey_id id, obs_hotkey_t *key) {
-			UNUSED_PARAMETER(id);
-			const auto hp = (struct find_hotkey *)param;
-			const auto hn = obs_hotkey_get_name(key);
-			if (strcmp(hp->name, hn) == 0) {
-				hp->hotkey = key;
-			}
-			return true;
-		},
-		&t);
-	if (t.hotkey) {
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), true);
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), false);
+	auto widget = registry_find_output(output_name);
+	if (widget) {
+		widget->TriggerHotkey(HotkeyAction::StopOutput);
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -315,6 +537,13 @@ void vendor_request_stop_all_recordings(obs_data_t *request_data, obs_data_t *re
 	obs_data_set_bool(response_data, "success", true);
 }
 
+struct vendor_backtrack_save {
+	const char *output_name;
+	uint32_t trim_sec;
+	uint64_t save_id;
+	bool pending;
+};
+
 void vendor_request_save_backtrack(obs_data_t *request_data, obs_data_t *response_data, void *)
 {
 	const char *output_name = obs_data_get_string(request_data, "output");
@@ -324,34 +553,44 @@ void vendor_request_save_backtrack(obs_data_t *request_data, obs_data_t *respons
 		return;
 	}
 
-	std::string saveName = "AitumStreamSuiteSaveBacktrack";
-	saveName += output_name;
-
-	struct find_hotkey {
-		obs_hotkey_t *hotkey;
-		const char *name;
-	};
-	find_hotkey t = {};
-	t.name = saveName.c_str();
-	obs_enum_hotkeys(
-		[](void *param, obs_hotkey_id id, obs_hotkey_t *key) {
-			UNUSED_PARAMETER(id);
-			const auto hp = (struct find_hotkey *)param;
-			const auto hn = obs_hotkey_get_name(key);
-			if (strcmp(hp->name, hn) == 0) {
-				hp->hotkey = key;
-			}
-			return true;
+	auto trim_sec = obs_data_get_int(request_data, "trim_sec");
+	if (trim_sec < 0) {
+		obs_data_set_string(response_data, "error", "'trim_sec' invalid");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	if (!output_dock) {
+		obs_data_set_string(response_data, "error", "Output dock not available");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	vendor_backtrack_save bs = {output_name, (uint32_t)trim_sec, 0, false};
+	// output widgets are created and destroyed on the ui thread, so look up and save there
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto bs = static_cast<vendor_backtrack_save *>(param);
+			auto ow = registry_find_output(bs->output_name);
+			if (!ow)
+				return;
+			bs->pending = ow->BacktrackSavePending();
+			if (!bs->pending)
+				bs->save_id = ow->RequestBacktrackSave(bs->trim_sec);
 		},
-		&t);
-	if (t.hotkey) {
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), true);
-		obs_hotkey_trigger_routed_callback(obs_hotkey_get_id(t.hotkey), false);
-		obs_data_set_bool(response_data, "success", true);
+		&bs, true);
+	if (bs.pending) {
+		obs_data_set_string(response_data, "error", "a save is already pending for 'output'");
+		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	obs_data_set_string(response_data, "error", "'output' not found");
-	obs_data_set_bool(response_data, "success", false);
+	if (!bs.save_id) {
+		obs_data_set_string(response_data, "error", "'output' not found or not active");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	// the path follows in a backtrack_saved event carrying the same save_id
+	obs_data_set_int(response_data, "save_id", (long long)bs.save_id);
+	obs_data_set_bool(response_data, "success", true);
 }
 
 void vendor_request_add_chapter(obs_data_t *request_data, obs_data_t *response_data, void *)
@@ -599,25 +838,17 @@ void vendor_request_dock_show_panel(obs_data_t *request_data, obs_data_t *respon
 		return;
 	}
 
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
 		auto pn = QString::fromUtf8(panel_name);
-		QMetaObject::invokeMethod(it, [it, pn] { it->SetPanelVisible(pn, true); });
+		QMetaObject::invokeMethod(cd, [cd, pn] { cd->SetPanelVisible(pn, true); });
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
-	for (const auto &it : canvas_clone_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto ccd = registry_find_canvas_clone_dock(canvas_name);
+	if (ccd) {
 		auto pn = QString::fromUtf8(panel_name);
-		QMetaObject::invokeMethod(it, [it, pn] { it->SetPanelVisible(pn, true); });
+		QMetaObject::invokeMethod(ccd, [ccd, pn] { ccd->SetPanelVisible(pn, true); });
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -641,25 +872,81 @@ void vendor_request_dock_hide_panel(obs_data_t *request_data, obs_data_t *respon
 		return;
 	}
 
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
 		auto pn = QString::fromUtf8(panel_name);
-		QMetaObject::invokeMethod(it, [it, pn] { it->SetPanelVisible(pn, false); });
+		QMetaObject::invokeMethod(cd, [cd, pn] { cd->SetPanelVisible(pn, false); });
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
-	for (const auto &it : canvas_clone_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
+	auto ccd = registry_find_canvas_clone_dock(canvas_name);
+	if (ccd) {
 		auto pn = QString::fromUtf8(panel_name);
-		QMetaObject::invokeMethod(it, [it, pn] { it->SetPanelVisible(pn, false); });
+		QMetaObject::invokeMethod(ccd, [ccd, pn] { ccd->SetPanelVisible(pn, false); });
+		obs_data_set_bool(response_data, "success", true);
+		return;
+	}
+
+	obs_data_set_string(response_data, "error", "'canvas' not found");
+	obs_data_set_bool(response_data, "success", false);
+}
+
+void vendor_request_dock_set_preview_policy(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (canvas_name[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'canvas' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	const char *policy_name = obs_data_get_string(request_data, "policy");
+	if (policy_name[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'policy' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	if (strcmp(preview_policy_to_string(preview_policy_from_string(policy_name)), policy_name) != 0) {
+		obs_data_set_string(response_data, "error", "'policy' must be full, reduced, hover or disabled");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	auto policy = preview_policy_from_string(policy_name);
+
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		QMetaObject::invokeMethod(cd, [cd, policy] { cd->SetPreviewPolicy(policy); });
+		obs_data_set_bool(response_data, "success", true);
+		return;
+	}
+	auto ccd = registry_find_canvas_clone_dock(canvas_name);
+	if (ccd) {
+		QMetaObject::invokeMethod(ccd, [ccd, policy] { ccd->SetPreviewPolicy(policy); });
+		obs_data_set_bool(response_data, "success", true);
+		return;
+	}
+
+	obs_data_set_string(response_data, "error", "'canvas' not found");
+	obs_data_set_bool(response_data, "success", false);
+}
+
+void vendor_request_dock_get_preview_policy(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (canvas_name[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'canvas' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		obs_data_set_string(response_data, "policy", preview_policy_to_string(cd->GetPreviewPolicy()));
+		obs_data_set_bool(response_data, "success", true);
+		return;
+	}
+	auto ccd = registry_find_canvas_clone_dock(canvas_name);
+	if (ccd) {
+		obs_data_set_string(response_data, "policy", preview_policy_to_string(ccd->GetPreviewPolicy()));
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -678,28 +965,9 @@ void vendor_request_get_transitions(obs_data_t *request_data, obs_data_t *respon
 		return;
 	}
 
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
-
-		auto ta = obs_data_array_create();
-		auto transitions = it->GetTransitions();
-		for (const auto &t : transitions) {
-			auto tr = obs_data_create();
-			obs_data_set_string(tr, "name", obs_source_get_name(t));
-			obs_data_set_string(tr, "uuid", obs_source_get_uuid(t));
-			obs_data_set_string(tr, "type", obs_source_get_id(t));
-			auto settings = obs_source_get_settings(t);
-			if (settings) {
-				obs_data_set_obj(tr, "settings", settings);
-				obs_data_release(settings);
-			}
-			obs_data_array_push_back(ta, tr);
-			obs_data_release(tr);
-		}
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		auto ta = canvas_transitions_array(cd);
 		obs_data_set_bool(response_data, "success", true);
 		obs_data_set_array(response_data, "transitions", ta);
 		obs_data_array_release(ta);
@@ -723,14 +991,9 @@ void vendor_request_switch_transition(obs_data_t *request_data, obs_data_t *resp
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
-
-		it->SetSelectedTransition(QString::fromUtf8(transition_name));
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		cd->SetSelectedTransition(QString::fromUtf8(transition_name));
 
 		obs_data_set_bool(response_data, "success", true);
 		return;
@@ -760,13 +1023,9 @@ void vendor_request_transitions_add(obs_data_t *request_data, obs_data_t *respon
 		return;
 	}
 	obs_data_t *settings = obs_data_get_obj(request_data, "settings");
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
-		it->AddTransition(transition_type, transition_name, settings);
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		cd->AddTransition(transition_type, transition_name, settings);
 		obs_data_set_bool(response_data, "success", true);
 		obs_data_release(settings);
 		return;
@@ -790,13 +1049,9 @@ void vendor_request_transitions_remove(obs_data_t *request_data, obs_data_t *res
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	for (const auto &it : canvas_docks) {
-		auto canvas = it->GetCanvas();
-		if (strcmp(obs_canvas_get_name(canvas), canvas_name) != 0 &&
-		    strcmp(obs_canvas_get_uuid(canvas), canvas_name) != 0) {
-			continue;
-		}
-		it->RemoveTransition(transition_name);
+	auto cd = registry_find_canvas_dock(canvas_name);
+	if (cd) {
+		cd->RemoveTransition(transition_name);
 		obs_data_set_bool(response_data, "success", true);
 		return;
 	}
@@ -858,49 +1113,323 @@ void vendor_request_reset_browser_panel(obs_data_t *request_data, obs_data_t *re
 	obs_data_set_bool(response_data, "success", false);
 }
 
-void load_obs_websocket()
+void vendor_request_get_browser_panels(obs_data_t *request_data, obs_data_t *response_data, void *)
 {
-	vendor = obs_websocket_register_vendor("aitum-stream-suite");
+	UNUSED_PARAMETER(request_data);
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto response_data = static_cast<obs_data_t *>(param);
+			auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+			if (!main_window) {
+				obs_data_set_string(response_data, "error", "Main window not available");
+				obs_data_set_bool(response_data, "success", false);
+				return;
+			}
+			auto pa = obs_data_array_create();
+			for (auto bd : main_window->findChildren<BrowserDock *>()) {
+				auto p = bd->GetState();
+				obs_data_array_push_back(pa, p);
+				obs_data_release(p);
+			}
+			obs_data_set_array(response_data, "panels", pa);
+			obs_data_array_release(pa);
+			obs_data_set_int(response_data, "loaded", BrowserDock::LoadedCount());
+			obs_data_set_int(response_data, "suspend_min", BrowserDock::SuspendMinutes());
+			obs_data_set_bool(response_data, "success", true);
+		},
+		response_data, true);
+}
 
-	obs_websocket_vendor_register_request(vendor, "version", vendor_request_version, nullptr);
-	obs_websocket_vendor_register_request(vendor, "get_canvas", vendor_request_get_canvas, nullptr);
-	obs_websocket_vendor_register_request(vendor, "switch_scene", vendor_request_switch_scene, nullptr);
-	obs_websocket_vendor_register_request(vendor, "current_scene", vendor_request_current_scene, nullptr);
-	obs_websocket_vendor_register_request(vendor, "get_scenes", vendor_request_get_scenes, nullptr);
+void vendor_request_subscribe_events(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *subscriber = obs_data_get_string(request_data, "subscriber");
+	if (subscriber[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'subscriber' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	uint32_t events = 0;
+	auto ea = obs_data_get_array(request_data, "events");
+	size_t count = obs_data_array_count(ea);
+	for (size_t i = 0; i < count; i++) {
+		auto e = obs_data_array_item(ea, i);
+		const char *name = obs_data_get_string(e, "name");
+		bool found = false;
+		for (const auto &c : vendor_event_categories) {
+			if (strcmp(c.name, name) == 0) {
+				events |= c.category;
+				found = true;
+			}
+		}
+		obs_data_release(e);
+		if (!found) {
+			obs_data_array_release(ea);
+			obs_data_set_string(response_data, "error", "'events' contains an unknown category");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+	}
+	obs_data_array_release(ea);
+	uint64_t expires = 0;
+	if (!vendor_subscription_expires(request_data, response_data, &expires))
+		return;
+
+	std::lock_guard<std::mutex> lock(vendor_subscriptions_mutex);
+	if (events)
+		vendor_subscriptions[subscriber] = {events, expires};
+	else
+		vendor_subscriptions.erase(subscriber);
+	vendor_update_subscribed_events();
+
+	auto sa = vendor_events_array(vendor_subscribed_events);
+	obs_data_set_array(response_data, "events", sa);
+	obs_data_array_release(sa);
+	obs_data_set_bool(response_data, "success", true);
+}
 
-	obs_websocket_vendor_register_request(vendor, "get_outputs", vendor_request_get_outputs, nullptr);
-	obs_websocket_vendor_register_request(vendor, "start_output", vendor_request_start_output, nullptr);
-	obs_websocket_vendor_register_request(vendor, "stop_output", vendor_request_stop_output, nullptr);
-	obs_websocket_vendor_register_request(vendor, "start_all_outputs", vendor_request_start_all_outputs, nullptr);
-	obs_websocket_vendor_register_request(vendor, "stop_all_outputs", vendor_request_stop_all_outputs, nullptr);
-	obs_websocket_vendor_register_request(vendor, "start_all_streams", vendor_request_start_all_streams, nullptr);
-	obs_websocket_vendor_register_request(vendor, "stop_all_streams", vendor_request_stop_all_streams, nullptr);
-	obs_websocket_vendor_register_request(vendor, "start_all_recordings", vendor_request_start_all_recordings, nullptr);
-	obs_websocket_vendor_register_request(vendor, "stop_all_recordings", vendor_request_stop_all_recordings, nullptr);
-	obs_websocket_vendor_register_request(vendor, "save_backtrack", vendor_request_save_backtrack, nullptr);
+void vendor_request_unsubscribe_events(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *subscriber = obs_data_get_string(request_data, "subscriber");
+	if (subscriber[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'subscriber' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(vendor_subscriptions_mutex);
+	vendor_subscriptions.erase(subscriber);
+	vendor_update_subscribed_events();
 
-	obs_websocket_vendor_register_request(vendor, "add_chapter", vendor_request_add_chapter, nullptr);
+	auto sa = vendor_events_array(vendor_subscribed_events);
+	obs_data_set_array(response_data, "events", sa);
+	obs_data_array_release(sa);
+	obs_data_set_bool(response_data, "success", true);
+}
 
-	obs_websocket_vendor_register_request(vendor, "get_dock_modes", vendor_request_get_dock_modes, nullptr);
-	obs_websocket_vendor_register_request(vendor, "switch_dock_mode", vendor_request_switch_dock_mode, nullptr);
-	obs_websocket_vendor_register_request(vendor, "get_docks", vendor_request_get_docks, nullptr);
-	obs_websocket_vendor_register_request(vendor, "dock_show", vendor_request_dock_show, nullptr);
-	obs_websocket_vendor_register_request(vendor, "dock_hide", vendor_request_dock_hide, nullptr);
+void vendor_request_subscribe_stats(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	const char *subscriber = obs_data_get_string(request_data, "subscriber");
+	if (subscriber[0] == '\0') {
+		obs_data_set_string(response_data, "error", "'subscriber' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	auto interval = obs_data_get_int(request_data, "interval_ms");
+	if (interval < 0) {
+		obs_data_set_string(response_data, "error", "'interval_ms' invalid");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	if (interval && interval < VENDOR_STATS_INTERVAL_MIN_MS)
+		interval = VENDOR_STATS_INTERVAL_MIN_MS;
+	else if (interval > VENDOR_STATS_INTERVAL_MAX_MS)
+		interval = VENDOR_STATS_INTERVAL_MAX_MS;
+	uint64_t expires = 0;
+	if (!vendor_subscription_expires(request_data, response_data, &expires))
+		return;
 
-	obs_websocket_vendor_register_request(vendor, "get_live_scenes", vendor_request_get_live_scenes, nullptr);
-	obs_websocket_vendor_register_request(vendor, "live_scenes_add", vendor_request_live_scenes_add, nullptr);
-	obs_websocket_vendor_register_request(vendor, "live_scenes_remove", vendor_request_live_scenes_remove, nullptr);
+	std::lock_guard<std::mutex> lock(vendor_subscriptions_mutex);
+	if (interval)
+		vendor_stats_subscriptions[subscriber] = {(uint32_t)interval, expires};
+	else
+		vendor_stats_subscriptions.erase(subscriber);
+	vendor_update_subscribed_events();
 
-	obs_websocket_vendor_register_request(vendor, "canvas_dock_show_panel", vendor_request_dock_show_panel, nullptr);
-	obs_websocket_vendor_register_request(vendor, "canvas_dock_hide_panel", vendor_request_dock_hide_panel, nullptr);
+	obs_data_set_int(response_data, "interval_ms", interval);
+	obs_data_set_int(response_data, "sample_interval_ms", vendor_stats_interval_ms);
+	obs_data_set_bool(response_data, "success", true);
+}
 
-	obs_websocket_vendor_register_request(vendor, "get_transitions", vendor_request_get_transitions, nullptr);
-	obs_websocket_vendor_register_request(vendor, "switch_transition", vendor_request_switch_transition, nullptr);
-	obs_websocket_vendor_register_request(vendor, "transitions_add", vendor_request_transitions_add, nullptr);
-	obs_websocket_vendor_register_request(vendor, "transitions_remove", vendor_request_transitions_remove, nullptr);
+void vendor_request_get_state(obs_data_t *request_data, obs_data_t *response_data, void *);
+void vendor_request_batch(obs_data_t *request_data, obs_data_t *response_data, void *);
+
+struct vendor_request_entry {
+	const char *name;
+	obs_websocket_request_callback_function callback;
+};
+
+static const vendor_request_entry vendor_requests[] = {
+	{"version", vendor_request_version},
+	{"get_canvas", vendor_request_get_canvas},
+	{"switch_scene", vendor_request_switch_scene},
+	{"current_scene", vendor_request_current_scene},
+	{"get_scenes", vendor_request_get_scenes},
+	{"get_linked_scenes", vendor_request_get_linked_scenes},
+	{"get_switch_latency", vendor_request_get_switch_latency},
+
+	{"get_outputs", vendor_request_get_outputs},
+	{"start_output", vendor_request_start_output},
+	{"stop_output", vendor_request_stop_output},
+	{"start_all_outputs", vendor_request_start_all_outputs},
+	{"stop_all_outputs", vendor_request_stop_all_outputs},
+	{"start_all_streams", vendor_request_start_all_streams},
+	{"stop_all_streams", vendor_request_stop_all_streams},
+	{"start_all_recordings", vendor_request_start_all_recordings},
+	{"stop_all_recordings", vendor_request_stop_all_recordings},
+	{"save_backtrack", vendor_request_save_backtrack},
+
+	{"add_chapter", vendor_request_add_chapter},
+
+	{"get_dock_modes", vendor_request_get_dock_modes},
+	{"switch_dock_mode", vendor_request_switch_dock_mode},
+	{"get_docks", vendor_request_get_docks},
+	{"dock_show", vendor_request_dock_show},
+	{"dock_hide", vendor_request_dock_hide},
+
+	{"get_live_scenes", vendor_request_get_live_scenes},
+	{"live_scenes_add", vendor_request_live_scenes_add},
+	{"live_scenes_remove", vendor_request_live_scenes_remove},
+
+	{"canvas_dock_show_panel", vendor_request_dock_show_panel},
+	{"canvas_dock_hide_panel", vendor_request_dock_hide_panel},
+	{"canvas_dock_get_preview_policy", vendor_request_dock_get_preview_policy},
+	{"canvas_dock_set_preview_policy", vendor_request_dock_set_preview_policy},
+
+	{"get_transitions", vendor_request_get_transitions},
+	{"switch_transition", vendor_request_switch_transition},
+	{"transitions_add", vendor_request_transitions_add},
+	{"transitions_remove", vendor_request_transitions_remove},
+
+	{"refresh_browser_panel", vendor_request_refresh_browser_panel},
+	{"reset_browser_panel", vendor_request_reset_browser_panel},
+	{"get_browser_panels", vendor_request_get_browser_panels},
+
+	{"get_state", vendor_request_get_state},
+	{"batch", vendor_request_batch},
+
+	{"subscribe_events", vendor_request_subscribe_events},
+	{"unsubscribe_events", vendor_request_unsubscribe_events},
+	{"subscribe_stats", vendor_request_subscribe_stats},
+};
+
+void vendor_request_get_state(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	UNUSED_PARAMETER(request_data);
+	// built in one ui task so the snapshot is consistent across canvases, outputs and live scenes
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto response_data = static_cast<obs_data_t *>(param);
+			obs_data_set_string(response_data, "version", PROJECT_VERSION);
+
+			auto ca = obs_data_array_create();
+			for (const auto &it : canvas_docks) {
+				auto c = canvas_data(it->GetCanvas(), "extra");
+				canvas_set_current_scene(it->GetCanvas(), c);
+				auto sa = canvas_scenes_array(it->GetCanvas());
+				obs_data_set_array(c, "scenes", sa);
+				obs_data_array_release(sa);
+				auto ta = canvas_transitions_array(it);
+				obs_data_set_array(c, "transitions", ta);
+				obs_data_array_release(ta);
+				obs_data_array_push_back(ca, c);
+				obs_data_release(c);
+			}
+			for (const auto &it : canvas_clone_docks) {
+				auto c = canvas_data(it->GetCanvas(), "clone");
+				obs_data_array_push_back(ca, c);
+				obs_data_release(c);
+			}
+			obs_data_set_array(response_data, "canvas", ca);
+			obs_data_array_release(ca);
+
+			if (output_dock) {
+				auto oa = output_dock->GetOutputsArray();
+				obs_data_set_array(response_data, "outputs", oa);
+				obs_data_array_release(oa);
+			}
+			if (live_scenes_dock) {
+				auto sa = live_scenes_dock->GetLiveScenesArray();
+				obs_data_set_array(response_data, "live_scenes", sa);
+				obs_data_array_release(sa);
+			}
+		},
+		response_data, true);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+struct vendor_batch {
+	obs_data_array_t *requests;
+	obs_data_array_t *results;
+	bool halt_on_failure;
+	bool success;
+};
+
+void vendor_request_batch(obs_data_t *request_data, obs_data_t *response_data, void *)
+{
+	vendor_batch batch = {};
+	batch.requests = obs_data_get_array(request_data, "requests");
+	if (!batch.requests) {
+		obs_data_set_string(response_data, "error", "'requests' not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	batch.results = obs_data_array_create();
+	batch.halt_on_failure = obs_data_get_bool(request_data, "halt_on_failure");
+	batch.success = true;
+
+	// all sub requests run in one ui task, in order, so nothing else interleaves with the batch
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *param) {
+			auto batch = static_cast<vendor_batch *>(param);
+			size_t count = obs_data_array_count(batch->requests);
+			for (size_t i = 0; i < count; i++) {
+				auto request = obs_data_array_item(batch->requests, i);
+				const char *request_type = obs_data_get_string(request, "request_type");
+				auto sub_request_data = obs_data_get_obj(request, "request_data");
+				if (!sub_request_data)
+					sub_request_data = obs_data_create();
+				auto sub_response_data = obs_data_create();
+
+				obs_websocket_request_callback_function callback = nullptr;
+				if (strcmp(request_type, "batch") != 0) {
+					for (const auto &r : vendor_requests) {
+						if (strcmp(r.name, request_type) == 0) {
+							callback = r.callback;
+							break;
+						}
+					}
+				}
+				if (callback) {
+					callback(sub_request_data, sub_response_data, nullptr);
+				} else {
+					obs_data_set_string(sub_response_data, "error", "'request_type' not found");
+					obs_data_set_bool(sub_response_data, "success", false);
+				}
+				bool success = obs_data_get_bool(sub_response_data, "success");
+
+				auto result = obs_data_create();
+				obs_data_set_string(result, "request_type", request_type);
+				obs_data_set_bool(result, "success", success);
+				obs_data_set_obj(result, "response_data", sub_response_data);
+				obs_data_array_push_back(batch->results, result);
+				obs_data_release(result);
+
+				obs_data_release(sub_response_data);
+				obs_data_release(sub_request_data);
+				obs_data_release(request);
+				if (!success) {
+					batch->success = false;
+					if (batch->halt_on_failure)
+						break;
+				}
+			}
+		},
+		&batch, true);
+
+	obs_data_set_array(response_data, "results", batch.results);
+	obs_data_set_bool(response_data, "success", batch.success);
+	obs_data_array_release(batch.results);
+	obs_data_array_release(batch.requests);
+}
+
+void load_obs_websocket()
+{
+	vendor = obs_websocket_register_vendor("aitum-stream-suite");
 
-	obs_websocket_vendor_register_request(vendor, "refresh_browser_panel", vendor_request_refresh_browser_panel, nullptr);
-	obs_websocket_vendor_register_request(vendor, "reset_browser_panel", vendor_request_reset_browser_panel, nullptr);
+	for (const auto &r : vendor_requests)
+		obs_websocket_vendor_register_request(vendor, r.name, r.callback, nullptr);
 }
 
 void unload_obs_websocket()
@@ -912,43 +1441,6 @@ void unload_obs_websocket()
 		vendor = nullptr;
 		return;
 	}
-	obs_websocket_vendor_unregister_request(vendor, "version");
-	obs_websocket_vendor_unregister_request(vendor, "get_canvas");
-	obs_websocket_vendor_unregister_request(vendor, "switch_scene");
-	obs_websocket_vendor_unregister_request(vendor, "current_scene");
-	obs_websocket_vendor_unregister_request(vendor, "get_scenes");
-
-	obs_websocket_vendor_unregister_request(vendor, "get_outputs");
-	obs_websocket_vendor_unregister_request(vendor, "start_output");
-	obs_websocket_vendor_unregister_request(vendor, "stop_output");
-	obs_websocket_vendor_unregister_request(vendor, "start_all_outputs");
-	obs_websocket_vendor_unregister_request(vendor, "stop_all_outputs");
-	obs_websocket_vendor_unregister_request(vendor, "start_all_streams");
-	obs_websocket_vendor_unregister_request(vendor, "stop_all_streams");
-	obs_websocket_vendor_unregister_request(vendor, "start_all_recordings");
-	obs_websocket_vendor_unregister_request(vendor, "stop_all_recordings");
-	obs_websocket_vendor_unregister_request(vendor, "save_backtrack");
-
-	obs_websocket_vendor_unregister_request(vendor, "add_chapter");
-
-	obs_websocket_vendor_unregister_request(vendor, "get_dock_modes");
-	obs_websocket_vendor_unregister_request(vendor, "switch_dock_mode");
-	obs_websocket_vendor_unregister_request(vendor, "get_docks");
-	obs_websocket_vendor_unregister_request(vendor, "dock_show");
-	obs_websocket_vendor_unregister_request(vendor, "dock_hide");
-
-	obs_websocket_vendor_unregister_request(vendor, "get_live_scenes");
-	obs_websocket_vendor_unregister_request(vendor, "live_scenes_add");
-	obs_websocket_vendor_unregister_request(vendor, "live_scenes_remove");
-
-	obs_websocket_vendor_unregister_request(vendor, "canvas_dock_show_panel");
-	obs_websocket_vendor_unregister_request(vendor, "canvas_dock_hide_panel");
-
-	obs_websocket_vendor_unregister_request(vendor, "get_transitions");
-	obs_websocket_vendor_unregister_request(vendor, "switch_transition");
-	obs_websocket_vendor_unregister_request(vendor, "transitions_add");
-	obs_websocket_vendor_unregister_request(vendor, "transitions_remove");
-
-	obs_websocket_vendor_unregister_request(vendor, "refresh_browser_panel");
-	obs_websocket_vendor_unregister_request(vendor, "reset_browser_panel");
+	for (const auto &r : vendor_requests)
+		obs_websocket_vendor_unregister_request(vendor, r.name);
 }
@@ -0,0 +1,142 @@
+#include "preview-texture.hpp"
+#include "canvas-map.hpp"
+#include <graphics/vec4.h>
+#include <mutex>
+#include <util/platform.h>
+
+#define PREVIEW_TEXTURE_EXPIRE_NS 5000000000ULL
+
+struct PreviewTexture : CanvasEntry {
+	gs_texrender_t *texrender = nullptr;
+	uint64_t frame_time = 0;
+	uint64_t rendered_frame_time = 0;
+	uint32_t draws_frame = 0;
+	uint32_t draws_last_frame = 0;
+	preview_texture_stats stats = {};
+};
+
+static void preview_texture_destroy(PreviewTexture &pt)
+{
+	gs_texrender_destroy(pt.texrender);
+}
+
+// entries are released inside the graphics context, they own a texrender
+static std::mutex preview_textures_mutex;
+static CanvasMap<PreviewTexture> preview_textures{preview_texture_destroy};
+static uint64_t preview_textures_pruned = 0;
+
+static void preview_texture_prune(uint64_t frame_time)
+{
+	preview_textures_pruned = frame_time;
+	for (auto it = preview_textures.begin(); it != preview_textures.end();) {
+		if (frame_time - it->second.frame_time < PREVIEW_TEXTURE_EXPIRE_NS &&
+		    !CanvasMap<PreviewTexture>::Expired(it->second)) {
+			++it;
+			continue;
+		}
+		it = preview_textures.Erase(it);
+	}
+}
+
+void preview_texture_draw(obs_canvas_t *canvas, uint32_t cx, uint32_t cy)
+{
+	if (!canvas) {
+		return;
+	}
+	const uint64_t frame_time = obs_get_video_frame_time();
+
+	std::lock_guard<std::mutex> lock(preview_textures_mutex);
+	if (frame_time - preview_textures_pruned >= PREVIEW_TEXTURE_EXPIRE_NS) {
+		preview_texture_prune(frame_time);
+	}
+	auto &pt = preview_textures.Get(canvas);
+	if (pt.frame_time != frame_time) {
+		pt.draws_last_frame = pt.draws_frame;
+		pt.draws_frame = 0;
+		pt.frame_time = frame_time;
+	}
+	pt.draws_frame++;
+	pt.stats.draws++;
+
+	// a canvas drawn by a single display is rendered directly, the texture only pays off when it is shared
+	if (pt.draws_last_frame < 2 && pt.draws_frame < 2) {
+		const uint64_t start = os_gettime_ns();
+		obs_canvas_render(canvas);
+		pt.stats.render_ns += os_gettime_ns() - start;
+		pt.stats.renders++;
+		return;
+	}
+
+	obs_video_info ovi;
+	if (!obs_canvas_get_video_info(canvas, &ovi) || !ovi.base_width || !ovi.base_height) {
+		obs_canvas_render(canvas);
+		return;
+	}
+
+	if (pt.rendered_frame_time != frame_time || !pt.texrender) {
+		if (!pt.texrender) {
+			pt.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+		}
+		const uint64_t start = os_gettime_ns();
+		gs_texrender_reset(pt.texrender);
+		if (gs_texrender_begin(pt.texrender, ovi.base_width, ovi.base_height)) {
+			struct vec4 clear_color;
+			vec4_zero(&clear_color);
+			gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+			const bool previous = gs_set_linear_srgb(true);
+			gs_ortho(0.0f, float(ovi.base_width), 0.0f, float(ovi.base_height), -100.0f, 100.0f);
+			obs_canvas_render(canvas);
+			gs_set_linear_srgb(previous);
+			gs_texrender_end(pt.texrender);
+		}
+		pt.stats.render_ns += os_gettime_ns() - start;
+		pt.stats.renders++;
+		pt.rendered_frame_time = frame_time;
+	}
+
+	gs_texture_t *tex = gs_texrender_get_texture(pt.texrender);
+	if (!tex) {
+		return;
+	}
+	const bool previous = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture_srgb(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw")) {
+		gs_draw_sprite(tex, 0, cx, cy);
+	}
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous);
+}
+
+bool preview_texture_get_stats(obs_canvas_t *canvas, struct preview_texture_stats *stats)
+{
+	std::lock_guard<std::mutex> lock(preview_textures_mutex);
+	auto pt = preview_textures.Find(canvas);
+	if (!pt) {
+		return false;
+	}
+	*stats = pt->stats;
+	return true;
+}
+
+void preview_texture_remove(obs_canvas_t *canvas)
+{
+	if (!canvas) {
+		return;
+	}
+	obs_enter_graphics();
+	std::lock_guard<std::mutex> lock(preview_textures_mutex);
+	preview_textures.Remove(canvas);
+	obs_leave_graphics();
+}
+
+void preview_texture_free_all()
+{
+	obs_enter_graphics();
+	std::lock_guard<std::mutex> lock(preview_textures_mutex);
+	preview_textures.Clear();
+	obs_leave_graphics();
+}
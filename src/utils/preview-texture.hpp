@@ -0,0 +1,15 @@
+#pragma once
+#include <obs.h>
+
+struct preview_texture_stats {
+	uint64_t renders;
+	uint64_t draws;
+	uint64_t render_ns;
+};
+
+// graphics thread only, draws the canvas at 0,0 to cx,cy in the current ortho
+void preview_texture_draw(obs_canvas_t *canvas, uint32_t cx, uint32_t cy);
+bool preview_texture_get_stats(obs_canvas_t *canvas, struct preview_texture_stats *stats);
+// drops the shared texture of a canvas that goes away
+void preview_texture_remove(obs_canvas_t *canvas);
+void preview_texture_free_all();
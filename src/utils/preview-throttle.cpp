@@ -0,0 +1,141 @@
+#include "preview-throttle.hpp"
+#include "event-filter.hpp"
+#include "preview-texture.hpp"
+#include <graphics/vec4.h>
+#include <obs-frontend-api.h>
+#include <QDockWidget>
+#include <util/platform.h>
+
+const char *preview_policy_to_string(PreviewPolicy policy)
+{
+	switch (policy) {
+	case PreviewPolicy::Reduced:
+		return "reduced";
+	case PreviewPolicy::Hover:
+		return "hover";
+	case PreviewPolicy::Disabled:
+		return "disabled";
+	default:
+		return "full";
+	}
+}
+
+PreviewPolicy preview_policy_from_string(const char *policy, PreviewPolicy def)
+{
+	if (!policy || policy[0] == '\0') {
+		return def;
+	}
+	if (strcmp(policy, "full") == 0) {
+		return PreviewPolicy::Full;
+	}
+	if (strcmp(policy, "reduced") == 0) {
+		return PreviewPolicy::Reduced;
+	}
+	if (strcmp(policy, "hover") == 0) {
+		return PreviewPolicy::Hover;
+	}
+	if (strcmp(policy, "disabled") == 0) {
+		return PreviewPolicy::Disabled;
+	}
+	return def;
+}
+
+PreviewThrottle::~PreviewThrottle()
+{
+	if (!texrender) {
+		return;
+	}
+	obs_enter_graphics();
+	gs_texrender_destroy(texrender);
+	obs_leave_graphics();
+}
+
+void PreviewThrottle::Render(obs_canvas_t *canvas, obs_source_t *source, uint32_t cx, uint32_t cy, uint32_t base_cx,
+			     uint32_t base_cy)
+{
+	const PreviewPolicy p = policy;
+	if (p == PreviewPolicy::Full || (p == PreviewPolicy::Hover && hovered)) {
+		if (source) {
+			obs_source_video_render(source);
+		} else {
+			preview_texture_draw(canvas, base_cx, base_cy);
+		}
+		last_render = 0;
+		return;
+	}
+	if (!cx || !cy) {
+		return;
+	}
+
+	const uint64_t now = os_gettime_ns();
+	bool refresh = !texrender || last_cx != cx || last_cy != cy || last_render == 0;
+	if (!refresh && p == PreviewPolicy::Reduced) {
+		refresh = now - last_render >= PREVIEW_REDUCED_INTERVAL_NS;
+	}
+
+	if (refresh) {
+		if (!texrender) {
+			texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+		}
+		gs_texrender_reset(texrender);
+		if (gs_texrender_begin(texrender, cx, cy)) {
+			struct vec4 clear_color;
+			vec4_zero(&clear_color);
+			gs_clear(GS_CLEAR_COLOR, &clear_color, 0.0f, 0);
+			gs_ortho(0.0f, float(base_cx), 0.0f, float(base_cy), -100.0f, 100.0f);
+			if (source) {
+				obs_source_video_render(source);
+			} else {
+				preview_texture_draw(canvas, base_cx, base_cy);
+			}
+			gs_texrender_end(texrender);
+		}
+		last_render = now;
+		last_cx = cx;
+		last_cy = cy;
+	}
+
+	gs_texture_t *tex = gs_texrender_get_texture(texrender);
+	if (!tex) {
+		return;
+	}
+	const bool previous = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture_srgb(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw")) {
+		gs_draw_sprite(tex, 0, base_cx, base_cy);
+	}
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previous);
+}
+
+void PreviewThrottle::WatchOcclusion(QWidget *widget, std::function<void(bool occluded)> changed)
+{
+	auto update = [widget, changed] {
+		changed(!widget->isVisible() || widget->window()->isMinimized());
+	};
+	QDockWidget *dock = nullptr;
+	for (QWidget *w = widget->parentWidget(); w && !dock; w = w->parentWidget()) {
+		dock = qobject_cast<QDockWidget *>(w);
+	}
+	auto filter = new OBSEventFilter([update](QObject *, QEvent *event) {
+		if (event->type() == QEvent::WindowStateChange) {
+			update();
+		}
+		return false;
+	});
+	filter->setParent(widget);
+	if (dock) {
+		QObject::connect(dock, &QDockWidget::visibilityChanged, widget, [update] { update(); });
+		QObject::connect(dock, &QDockWidget::topLevelChanged, widget, [update] { update(); });
+		dock->installEventFilter(filter);
+	}
+	auto main_window = static_cast<QWidget *>(obs_frontend_get_main_window());
+	if (main_window) {
+		main_window->installEventFilter(filter);
+	}
+	update();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <obs.h>
+#include <QWidget>
+
+#define PREVIEW_REDUCED_INTERVAL_NS 100000000ULL
+
+enum class PreviewPolicy : int {
+	Full = 0,
+	Reduced,
+	Hover,
+	Disabled,
+};
+
+const char *preview_policy_to_string(PreviewPolicy policy);
+PreviewPolicy preview_policy_from_string(const char *policy, PreviewPolicy def = PreviewPolicy::Full);
+
+class PreviewThrottle {
+private:
+	std::atomic<PreviewPolicy> policy = PreviewPolicy::Full;
+	std::atomic_bool hovered = false;
+	gs_texrender_t *texrender = nullptr;
+	uint64_t last_render = 0;
+	uint32_t last_cx = 0;
+	uint32_t last_cy = 0;
+
+public:
+	~PreviewThrottle();
+
+	PreviewPolicy GetPolicy() const { return policy; }
+	void SetPolicy(PreviewPolicy p) { policy = p; }
+	void SetHovered(bool h) { hovered = h; }
+
+	// call from the draw callback with the ortho set to the canvas size, renders live or reuses the last frame
+	void Render(obs_canvas_t *canvas, obs_source_t *source, uint32_t cx, uint32_t cy, uint32_t base_cx, uint32_t base_cy);
+
+	static void WatchOcclusion(QWidget *widget, std::function<void(bool occluded)> changed);
+};
@@ -0,0 +1,112 @@
+#include "properties-cache.hpp"
+#include <map>
+#include <obs.hpp>
+#include <QPointer>
+#include <QThreadPool>
+#include <string>
+#include <util/platform.h>
+#include <vector>
+
+struct PropertiesCacheEntry {
+	OBSWeakSource source;
+	std::shared_ptr<obs_properties_t> properties;
+	uint64_t time = 0;
+	uint64_t generation = 0;
+	bool loading = false;
+	std::vector<std::pair<QPointer<QObject>, PropertiesCallback>> waiting;
+};
+
+static std::map<std::string, PropertiesCacheEntry> properties_cache;
+static QThreadPool *properties_cache_pool = nullptr;
+static QObject *properties_cache_context = nullptr;
+
+static void properties_cache_load(const std::string &uuid, PropertiesCacheEntry &entry)
+{
+	if (!properties_cache_pool) {
+		properties_cache_pool = new QThreadPool;
+		properties_cache_pool->setMaxThreadCount(2);
+		properties_cache_context = new QObject;
+	}
+	entry.loading = true;
+	OBSWeakSource weak = entry.source;
+	uint64_t generation = entry.generation;
+	properties_cache_pool->start([uuid, weak, generation] {
+		OBSSourceAutoRelease source = obs_weak_source_get_source(weak);
+		std::shared_ptr<obs_properties_t> properties;
+		if (source)
+			properties.reset(obs_source_properties(source), obs_properties_destroy);
+
+		QMetaObject::invokeMethod(
+			properties_cache_context,
+			[uuid, generation, properties] {
+				auto it = properties_cache.find(uuid);
+				if (it == properties_cache.end())
+					return;
+				auto &entry = it->second;
+				if (entry.generation != generation) {
+					properties_cache_load(uuid, entry);
+					return;
+				}
+				entry.loading = false;
+				entry.properties = properties;
+				entry.time = os_gettime_ns();
+				auto waiting = std::move(entry.waiting);
+				entry.waiting.clear();
+				for (auto &w : waiting) {
+					if (w.first)
+						w.second(properties);
+				}
+			},
+			Qt::QueuedConnection);
+	});
+}
+
+void properties_cache_get(obs_source_t *source, QObject *receiver, PropertiesCallback callback)
+{
+	if (!source)
+		return;
+	const uint64_t now = os_gettime_ns();
+	for (auto it = properties_cache.begin(); it != properties_cache.end();) {
+		if (!it->second.loading && now - it->second.time >= PROPERTIES_CACHE_TTL_NS)
+			it = properties_cache.erase(it);
+		else
+			++it;
+	}
+
+	std::string uuid = obs_source_get_uuid(source);
+	auto &entry = properties_cache[uuid];
+	if (!entry.loading && entry.time) {
+		auto properties = entry.properties;
+		callback(properties);
+		return;
+	}
+	entry.waiting.emplace_back(receiver, callback);
+	if (entry.loading)
+		return;
+	entry.source = OBSGetWeakRef(source);
+	properties_cache_load(uuid, entry);
+}
+
+void properties_cache_invalidate(obs_source_t *source)
+{
+	if (!source)
+		return;
+	auto it = properties_cache.find(obs_source_get_uuid(source));
+	if (it == properties_cache.end())
+		return;
+	it->second.generation++;
+	it->second.time = 0;
+	it->second.properties.reset();
+}
+
+void properties_cache_free()
+{
+	if (properties_cache_pool) {
+		properties_cache_pool->waitForDone();
+		delete properties_cache_pool;
+		properties_cache_pool = nullptr;
+		delete properties_cache_context;
+		properties_cache_context = nullptr;
+	}
+	properties_cache.clear();
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <obs.h>
+#include <QObject>
+
+#define PROPERTIES_CACHE_TTL_NS 5000000000ULL
+
+typedef std::function<void(std::shared_ptr<obs_properties_t> properties)> PropertiesCallback;
+
+// ui thread only, enumerates the properties on a worker thread unless a result younger than the ttl is cached,
+// the callback runs on the ui thread and is dropped when the receiver is gone
+void properties_cache_get(obs_source_t *source, QObject *receiver, PropertiesCallback callback);
+void properties_cache_invalidate(obs_source_t *source);
+void properties_cache_free();
@@ -0,0 +1,34 @@
+#include "refresh-coalescer.hpp"
+#include <algorithm>
+
+RefreshCoalescer::RefreshCoalescer(QObject *parent, std::function<void()> refresh, int interval_ms)
+	: timer(new QTimer(parent)),
+	  refresh(refresh),
+	  interval(interval_ms)
+{
+	timer->setSingleShot(true);
+	QObject::connect(timer, &QTimer::timeout, parent, [this] {
+		last.restart();
+		this->refresh();
+	});
+}
+
+void RefreshCoalescer::Trigger()
+{
+	if (timer->isActive())
+		return;
+	qint64 delay = 0;
+	if (last.isValid())
+		delay = std::max<qint64>(0, interval - last.elapsed());
+	timer->start((int)delay);
+}
+
+bool RefreshCoalescer::Flush()
+{
+	if (!timer->isActive())
+		return false;
+	timer->stop();
+	last.restart();
+	refresh();
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <functional>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#define REFRESH_COALESCE_INTERVAL_MS 100
+
+// runs the refresh on the next event loop turn, at most once per interval, so bursts only rebuild for the latest state
+class RefreshCoalescer {
+private:
+	QTimer *timer;
+	QElapsedTimer last;
+	std::function<void()> refresh;
+	int interval;
+
+public:
+	RefreshCoalescer(QObject *parent, std::function<void()> refresh, int interval_ms = REFRESH_COALESCE_INTERVAL_MS);
+
+	void Trigger();
+	// runs a pending refresh right away, returns whether one was pending
+	bool Flush();
+	void Cancel() { timer->stop(); }
+	bool IsPending() const { return timer->isActive(); }
+};
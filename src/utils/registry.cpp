@@ -0,0 +1,136 @@
+#include "registry.hpp"
+#include "../docks/canvas-clone-dock.hpp"
+#include "../docks/canvas-dock.hpp"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+template<typename T> struct CanvasIndex {
+	std::vector<T *> docks;
+	std::unordered_map<std::string, T *> by_name;
+	std::unordered_map<std::string, T *> by_uuid;
+
+	static const char *Name(T *dock)
+	{
+		auto canvas = dock->GetCanvas();
+		auto name = canvas ? obs_canvas_get_name(canvas) : nullptr;
+		return name ? name : "";
+	}
+
+	static const char *Uuid(T *dock)
+	{
+		auto canvas = dock->GetCanvas();
+		auto uuid = canvas ? obs_canvas_get_uuid(canvas) : nullptr;
+		return uuid ? uuid : "";
+	}
+
+	void Rebuild()
+	{
+		by_name.clear();
+		by_uuid.clear();
+		for (auto dock : docks) {
+			by_name.emplace(Name(dock), dock);
+			by_uuid.emplace(Uuid(dock), dock);
+		}
+	}
+
+	void Add(T *dock)
+	{
+		if (std::find(docks.begin(), docks.end(), dock) == docks.end())
+			docks.push_back(dock);
+		Rebuild();
+	}
+
+	void Remove(T *dock)
+	{
+		docks.erase(std::remove(docks.begin(), docks.end(), dock), docks.end());
+		Rebuild();
+	}
+
+	T *Lookup(const char *key, bool verify)
+	{
+		auto it = by_name.find(key);
+		if (it != by_name.end() && (!verify || strcmp(Name(it->second), key) == 0))
+			return it->second;
+		it = by_uuid.find(key);
+		if (it != by_uuid.end() && (!verify || strcmp(Uuid(it->second), key) == 0))
+			return it->second;
+		return nullptr;
+	}
+
+	T *Find(const char *key)
+	{
+		if (!key || key[0] == '\0')
+			return nullptr;
+		auto dock = Lookup(key, true);
+		if (dock)
+			return dock;
+		// canvases get renamed or replaced on collection changes, rescan before reporting a miss
+		Rebuild();
+		return Lookup(key, false);
+	}
+};
+
+static std::mutex registry_mutex;
+static CanvasIndex<CanvasDock> registry_canvas_docks;
+static CanvasIndex<CanvasCloneDock> registry_canvas_clone_docks;
+static std::unordered_map<std::string, OutputWidget *> registry_outputs;
+
+void registry_add_canvas_dock(CanvasDock *dock)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry_canvas_docks.Add(dock);
+}
+
+void registry_remove_canvas_dock(CanvasDock *dock)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry_canvas_docks.Remove(dock);
+}
+
+CanvasDock *registry_find_canvas_dock(const char *name_or_uuid)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	return registry_canvas_docks.Find(name_or_uuid);
+}
+
+void registry_add_canvas_clone_dock(CanvasCloneDock *dock)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry_canvas_clone_docks.Add(dock);
+}
+
+void registry_remove_canvas_clone_dock(CanvasCloneDock *dock)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry_canvas_clone_docks.Remove(dock);
+}
+
+CanvasCloneDock *registry_find_canvas_clone_dock(const char *name_or_uuid)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	return registry_canvas_clone_docks.Find(name_or_uuid);
+}
+
+void registry_add_output(const char *name, OutputWidget *widget)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry_outputs[name] = widget;
+}
+
+void registry_remove_output(const char *name, OutputWidget *widget)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	auto it = registry_outputs.find(name);
+	if (it != registry_outputs.end() && it->second == widget)
+		registry_outputs.erase(it);
+}
+
+OutputWidget *registry_find_output(const char *name)
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	auto it = registry_outputs.find(name);
+	return it == registry_outputs.end() ? nullptr : it->second;
+}
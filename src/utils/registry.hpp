@@ -0,0 +1,19 @@
+#pragma once
+#include <obs.h>
+
+class CanvasDock;
+class CanvasCloneDock;
+class OutputWidget;
+
+// name and uuid lookups used by the vendor requests, a miss falls back to a scan and rebuilds the index
+void registry_add_canvas_dock(CanvasDock *dock);
+void registry_remove_canvas_dock(CanvasDock *dock);
+CanvasDock *registry_find_canvas_dock(const char *name_or_uuid);
+
+void registry_add_canvas_clone_dock(CanvasCloneDock *dock);
+void registry_remove_canvas_clone_dock(CanvasCloneDock *dock);
+CanvasCloneDock *registry_find_canvas_clone_dock(const char *name_or_uuid);
+
+void registry_add_output(const char *name, OutputWidget *widget);
+void registry_remove_output(const char *name, OutputWidget *widget);
+OutputWidget *registry_find_output(const char *name);
@@ -0,0 +1,88 @@
+#include "scene-index.hpp"
+
+// rows without a uuid (older saves) are keyed by their name instead
+QString SceneIndex::Uuid(const QListWidgetItem *item)
+{
+	auto uuid = item->data(Qt::UserRole).toString();
+	return uuid.isEmpty() ? item->text() : uuid;
+}
+
+QListWidgetItem *SceneIndex::Add(const QString &name, const QString &uuid, int row)
+{
+	if (!list)
+		return nullptr;
+	auto item = new QListWidgetItem(name);
+	item->setData(Qt::UserRole, uuid);
+	if (row < 0)
+		list->addItem(item);
+	else
+		list->insertItem(row, item);
+	auto key = Uuid(item);
+	by_uuid.insert(key, item);
+	name_to_uuid.insert(name, key);
+	return item;
+}
+
+QListWidgetItem *SceneIndex::Add(obs_source_t *scene, int row)
+{
+	return Add(QString::fromUtf8(obs_source_get_name(scene)), QString::fromUtf8(obs_source_get_uuid(scene)), row);
+}
+
+void SceneIndex::Remove(QListWidgetItem *item)
+{
+	if (!list || !item)
+		return;
+	auto key = Uuid(item);
+	if (by_uuid.value(key) == item)
+		by_uuid.remove(key);
+	if (name_to_uuid.value(item->text()) == key)
+		name_to_uuid.remove(item->text());
+	delete list->takeItem(list->row(item));
+}
+
+bool SceneIndex::Rename(QListWidgetItem *item, const QString &name)
+{
+	if (!item || item->text() == name)
+		return false;
+	auto key = Uuid(item);
+	if (name_to_uuid.value(item->text()) == key)
+		name_to_uuid.remove(item->text());
+	if (item->data(Qt::UserRole).toString().isEmpty()) {
+		by_uuid.remove(key);
+		by_uuid.insert(name, item);
+		key = name;
+	}
+	item->setText(name);
+	name_to_uuid.insert(name, key);
+	return true;
+}
+
+void SceneIndex::Clear()
+{
+	by_uuid.clear();
+	name_to_uuid.clear();
+	if (list)
+		list->clear();
+}
+
+QListWidgetItem *SceneIndex::FindByUuid(const QString &uuid) const
+{
+	return uuid.isEmpty() ? nullptr : by_uuid.value(uuid);
+}
+
+QListWidgetItem *SceneIndex::FindByName(const QString &name) const
+{
+	auto it = name_to_uuid.constFind(name);
+	if (it == name_to_uuid.constEnd())
+		return nullptr;
+	auto item = by_uuid.value(it.value());
+	return item && item->text() == name ? item : nullptr;
+}
+
+QListWidgetItem *SceneIndex::Find(obs_source_t *scene) const
+{
+	if (!scene)
+		return nullptr;
+	auto item = FindByUuid(QString::fromUtf8(obs_source_get_uuid(scene)));
+	return item ? item : FindByName(QString::fromUtf8(obs_source_get_name(scene)));
+}
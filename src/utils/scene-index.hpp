@@ -0,0 +1,29 @@
+#pragma once
+#include <obs.h>
+#include <QHash>
+#include <QListWidget>
+
+// uuid and name lookups for the rows of a scene list, kept in step with the add, remove and rename signals
+class SceneIndex {
+private:
+	QListWidget *list = nullptr;
+	QHash<QString, QListWidgetItem *> by_uuid;
+	QHash<QString, QString> name_to_uuid;
+
+	static QString Uuid(const QListWidgetItem *item);
+
+public:
+	void Bind(QListWidget *l) { list = l; }
+
+	QListWidgetItem *Add(const QString &name, const QString &uuid, int row = -1);
+	QListWidgetItem *Add(obs_source_t *scene, int row = -1);
+	void Remove(QListWidgetItem *item);
+	bool Rename(QListWidgetItem *item, const QString &name);
+	void Clear();
+
+	QListWidgetItem *FindByUuid(const QString &uuid) const;
+	QListWidgetItem *FindByName(const QString &name) const;
+	QListWidgetItem *Find(obs_source_t *scene) const;
+	QString UuidForName(const QString &name) const { return name_to_uuid.value(name); }
+	int Row(const QListWidgetItem *item) const { return item && list ? list->row(item) : -1; }
+};
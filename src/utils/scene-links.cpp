@@ -0,0 +1,241 @@
+#include "scene-links.hpp"
+#include <algorithm>
+#include <mutex>
+#include <obs-frontend-api.h>
+#include <unordered_map>
+#include <unordered_set>
+
+struct unnamed_link {
+	std::string main_uuid;
+	long long width;
+	long long height;
+	std::string scene;
+};
+
+static std::mutex links_mutex;
+static bool links_dirty = true;
+// main scene uuid -> canvas name -> canvas scene name
+static std::unordered_map<std::string, std::unordered_map<std::string, std::string>> links_by_main;
+// canvas name -> canvas scene name -> main scene uuids
+static std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<std::string>>> links_by_canvas;
+static std::vector<unnamed_link> links_unnamed;
+
+static void links_insert(const std::string &uuid, const std::string &canvas_name, const std::string &scene)
+{
+	// the first entry for a canvas wins, like the settings walks this replaces
+	if (links_by_main[uuid].emplace(canvas_name, scene).second)
+		links_by_canvas[canvas_name][scene].insert(uuid);
+}
+
+static void links_unlink(const std::string &uuid, const std::string &canvas_name, const std::string &scene)
+{
+	auto c = links_by_canvas.find(canvas_name);
+	if (c == links_by_canvas.end())
+		return;
+	auto s = c->second.find(scene);
+	if (s == c->second.end())
+		return;
+	s->second.erase(uuid);
+	if (s->second.empty())
+		c->second.erase(s);
+}
+
+static void links_erase_main(const std::string &uuid)
+{
+	auto it = links_by_main.find(uuid);
+	if (it != links_by_main.end()) {
+		for (const auto &link : it->second)
+			links_unlink(uuid, link.first, link.second);
+		links_by_main.erase(it);
+	}
+	links_unnamed.erase(std::remove_if(links_unnamed.begin(), links_unnamed.end(),
+					   [&uuid](const unnamed_link &l) { return l.main_uuid == uuid; }),
+			    links_unnamed.end());
+}
+
+static void links_parse(obs_source_t *main_scene)
+{
+	std::string uuid = obs_source_get_uuid(main_scene);
+	links_erase_main(uuid);
+	auto settings = obs_source_get_settings(main_scene);
+	auto c = obs_data_get_array(settings, "canvas");
+	obs_data_release(settings);
+	if (!c)
+		return;
+	const auto count = obs_data_array_count(c);
+	for (size_t i = 0; i < count; i++) {
+		auto item = obs_data_array_item(c, i);
+		if (!item)
+			continue;
+		const char *name = obs_data_get_string(item, "name");
+		const char *scene = obs_data_get_string(item, "scene");
+		if (name[0] == '\0') {
+			links_unnamed.push_back(
+				{uuid, obs_data_get_int(item, "width"), obs_data_get_int(item, "height"), scene});
+		} else {
+			links_insert(uuid, name, scene);
+		}
+		obs_data_release(item);
+	}
+	obs_data_array_release(c);
+}
+
+static void links_ensure()
+{
+	if (!links_dirty)
+		return;
+	links_dirty = false;
+	links_by_main.clear();
+	links_by_canvas.clear();
+	links_unnamed.clear();
+	struct obs_frontend_source_list scenes = {};
+	obs_frontend_get_scenes(&scenes);
+	for (size_t i = 0; i < scenes.sources.num; i++)
+		links_parse(scenes.sources.array[i]);
+	obs_frontend_source_list_free(&scenes);
+}
+
+void scene_links_invalidate()
+{
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_dirty = true;
+}
+
+void scene_links_reload(obs_source_t *main_scene)
+{
+	if (!main_scene)
+		return;
+	std::lock_guard<std::mutex> lock(links_mutex);
+	if (links_dirty) {
+		links_ensure();
+		return;
+	}
+	links_parse(main_scene);
+}
+
+void scene_links_adopt(const char *canvas_name, uint32_t width, uint32_t height)
+{
+	if (!canvas_name || canvas_name[0] == '\0')
+		return;
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_ensure();
+	for (auto it = links_unnamed.begin(); it != links_unnamed.end();) {
+		auto main_links = links_by_main.find(it->main_uuid);
+		if (it->width != width || it->height != height ||
+		    (main_links != links_by_main.end() && main_links->second.count(canvas_name))) {
+			++it;
+			continue;
+		}
+		auto main_scene = obs_get_source_by_uuid(it->main_uuid.c_str());
+		auto settings = obs_source_get_settings(main_scene);
+		auto c = obs_data_get_array(settings, "canvas");
+		const auto count = obs_data_array_count(c);
+		for (size_t i = 0; i < count; i++) {
+			auto item = obs_data_array_item(c, i);
+			if (!item)
+				continue;
+			bool match = obs_data_get_string(item, "name")[0] == '\0' && obs_data_get_int(item, "width") == width &&
+				     obs_data_get_int(item, "height") == height;
+			if (match)
+				obs_data_set_string(item, "name", canvas_name);
+			obs_data_release(item);
+			if (match)
+				break;
+		}
+		obs_data_array_release(c);
+		obs_data_release(settings);
+		obs_source_release(main_scene);
+
+		links_insert(it->main_uuid, canvas_name, it->scene);
+		it = links_unnamed.erase(it);
+	}
+}
+
+std::string scene_links_get(obs_source_t *main_scene, const char *canvas_name)
+{
+	if (!main_scene || !canvas_name)
+		return "";
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_ensure();
+	auto it = links_by_main.find(obs_source_get_uuid(main_scene));
+	if (it == links_by_main.end())
+		return "";
+	auto link = it->second.find(canvas_name);
+	return link == it->second.end() ? "" : link->second;
+}
+
+std::vector<std::string> scene_links_canvas_scenes(const char *canvas_name)
+{
+	std::vector<std::string> scenes;
+	if (!canvas_name)
+		return scenes;
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_ensure();
+	auto c = links_by_canvas.find(canvas_name);
+	if (c == links_by_canvas.end())
+		return scenes;
+	scenes.reserve(c->second.size());
+	for (const auto &s : c->second)
+		scenes.push_back(s.first);
+	return scenes;
+}
+
+void scene_links_rename_canvas_scene(const char *canvas_name, const char *prev_name, const char *new_name)
+{
+	if (!canvas_name || !prev_name || !new_name)
+		return;
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_ensure();
+	auto c = links_by_canvas.find(canvas_name);
+	if (c == links_by_canvas.end())
+		return;
+	auto s = c->second.find(prev_name);
+	if (s == c->second.end())
+		return;
+	// only the main scenes linked to the renamed scene get their settings rewritten
+	auto uuids = std::move(s->second);
+	c->second.erase(s);
+	for (const auto &uuid : uuids) {
+		links_by_main[uuid][canvas_name] = new_name;
+		c->second[new_name].insert(uuid);
+
+		auto main_scene = obs_get_source_by_uuid(uuid.c_str());
+		auto settings = obs_source_get_settings(main_scene);
+		auto a = obs_data_get_array(settings, "canvas");
+		const auto count = obs_data_array_count(a);
+		for (size_t i = 0; i < count; i++) {
+			auto item = obs_data_array_item(a, i);
+			if (item && strcmp(obs_data_get_string(item, "name"), canvas_name) == 0 &&
+			    strcmp(obs_data_get_string(item, "scene"), prev_name) == 0)
+				obs_data_set_string(item, "scene", new_name);
+			obs_data_release(item);
+		}
+		obs_data_array_release(a);
+		obs_data_release(settings);
+		obs_source_release(main_scene);
+	}
+}
+
+obs_data_array_t *scene_links_array(const char *canvas_name)
+{
+	auto links = obs_data_array_create();
+	std::lock_guard<std::mutex> lock(links_mutex);
+	links_ensure();
+	for (const auto &main : links_by_main) {
+		auto main_scene = obs_get_source_by_uuid(main.first.c_str());
+		const char *scene_name = main_scene ? obs_source_get_name(main_scene) : "";
+		for (const auto &link : main.second) {
+			if (canvas_name && canvas_name[0] != '\0' && link.first != canvas_name)
+				continue;
+			auto l = obs_data_create();
+			obs_data_set_string(l, "scene", scene_name);
+			obs_data_set_string(l, "scene_uuid", main.first.c_str());
+			obs_data_set_string(l, "canvas", link.first.c_str());
+			obs_data_set_string(l, "canvas_scene", link.second.c_str());
+			obs_data_array_push_back(links, l);
+			obs_data_release(l);
+		}
+		obs_source_release(main_scene);
+	}
+	return links;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <obs.h>
+#include <string>
+#include <vector>
+
+// cached graph of the main scene -> canvas scene links stored in each main scene's "canvas" settings array,
+// rebuilt lazily after the main scene list changes and patched in place when a link is written or renamed
+void scene_links_invalidate();
+void scene_links_reload(obs_source_t *main_scene);
+
+// links saved before canvases had names only carry the canvas size, claim them for the named canvas
+void scene_links_adopt(const char *canvas_name, uint32_t width, uint32_t height);
+
+std::string scene_links_get(obs_source_t *main_scene, const char *canvas_name);
+std::vector<std::string> scene_links_canvas_scenes(const char *canvas_name);
+void scene_links_rename_canvas_scene(const char *canvas_name, const char *prev_name, const char *new_name);
+
+// array of {scene, scene_uuid, canvas, canvas_scene}, all canvases when canvas_name is empty
+obs_data_array_t *scene_links_array(const char *canvas_name);
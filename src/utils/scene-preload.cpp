@@ -0,0 +1,58 @@
+#include "scene-preload.hpp"
+#include <algorithm>
+
+extern obs_data_t *current_profile_config;
+
+int ScenePreloader::MaxScenes()
+{
+	if (!current_profile_config || !obs_data_has_user_value(current_profile_config, "preload_scenes_max"))
+		return SCENE_PRELOAD_DEFAULT_MAX;
+	return (int)obs_data_get_int(current_profile_config, "preload_scenes_max");
+}
+
+void ScenePreloader::Release(obs_weak_source_t *weak)
+{
+	obs_source_t *source = obs_weak_source_get_source(weak);
+	if (source) {
+		obs_source_dec_showing(source);
+		obs_source_release(source);
+	}
+	obs_weak_source_release(weak);
+}
+
+void ScenePreloader::Update(const std::vector<obs_source_t *> &candidates)
+{
+	const size_t budget = (size_t)std::max(MaxScenes(), 0);
+	std::vector<obs_source_t *> wanted;
+	for (auto source : candidates) {
+		if (wanted.size() >= budget)
+			break;
+		if (!source || obs_source_removed(source) || std::find(wanted.begin(), wanted.end(), source) != wanted.end())
+			continue;
+		wanted.push_back(source);
+	}
+
+	std::vector<obs_weak_source_t *> next;
+	for (auto weak : warm) {
+		auto it = std::find_if(wanted.begin(), wanted.end(),
+				       [weak](obs_source_t *source) { return obs_weak_source_references_source(weak, source); });
+		if (it == wanted.end()) {
+			Release(weak);
+			continue;
+		}
+		next.push_back(weak);
+		wanted.erase(it);
+	}
+	for (auto source : wanted) {
+		obs_source_inc_showing(source);
+		next.push_back(obs_source_get_weak_source(source));
+	}
+	warm = std::move(next);
+}
+
+void ScenePreloader::Clear()
+{
+	for (auto weak : warm)
+		Release(weak);
+	warm.clear();
+}
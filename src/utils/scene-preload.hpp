@@ -0,0 +1,23 @@
+#pragma once
+#include <obs.h>
+#include <vector>
+
+#define SCENE_PRELOAD_DEFAULT_MAX 0
+
+// keeps the scenes most likely to go live next showing, so their sources are loaded before the cut instead of on it
+class ScenePreloader {
+private:
+	std::vector<obs_weak_source_t *> warm;
+
+	static void Release(obs_weak_source_t *weak);
+
+public:
+	~ScenePreloader() { Clear(); }
+
+	// candidates in priority order, anything past the configured budget stays cold
+	void Update(const std::vector<obs_source_t *> &candidates);
+	void Clear();
+	size_t Count() const { return warm.size(); }
+
+	static int MaxScenes();
+};
@@ -0,0 +1,254 @@
+#include "switch-latency.hpp"
+#include "canvas-map.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <util/platform.h>
+
+const uint32_t switch_latency_bucket_ms[SWITCH_LATENCY_BUCKETS] = {16, 33, 50, 100, 200, 500, 1000, 2000, 5000, 0};
+
+struct SwitchLatency : CanvasEntry {
+	uintptr_t id = 0;
+	uint64_t request_ns = 0;
+	uint64_t request_frames = 0;
+	const char *request_origin = nullptr;
+	uint64_t switch_ns = 0;
+	uint64_t switch_frames = 0;
+	const char *switch_origin = nullptr;
+	bool applied = false;
+	int ticks = 0;
+	uint64_t transition_start_ns = 0;
+	uint64_t transition_start_frames = 0;
+	switch_latency_stats stats = {};
+};
+
+static int switch_latency_pending = 0;
+
+// a dropped entry can still have a switch waiting for the tick, which then no longer counts
+static void switch_latency_destroy(SwitchLatency &sl)
+{
+	if (sl.applied)
+		switch_latency_pending--;
+}
+
+static std::mutex switch_latency_mutex;
+static CanvasMap<SwitchLatency> switch_latencies{switch_latency_destroy};
+// transition signals outlive the entry they were connected for, so they carry an id that is never handed out twice
+static uintptr_t switch_latency_last_id = 0;
+static bool switch_latency_ticking = false;
+
+static uint64_t canvas_frames(obs_canvas_t *canvas)
+{
+	auto video = obs_canvas_get_video(canvas);
+	return video ? video_output_get_total_frames(video) : 0;
+}
+
+static SwitchLatency &switch_latency_entry(obs_canvas_t *canvas)
+{
+	auto &sl = switch_latencies.Get(canvas);
+	if (!sl.id)
+		sl.id = ++switch_latency_last_id;
+	return sl;
+}
+
+static SwitchLatency *switch_latency_find_id(void *data)
+{
+	for (auto &it : switch_latencies) {
+		if (it.second.id == (uintptr_t)data)
+			return &it.second;
+	}
+	return nullptr;
+}
+
+static void switch_latency_record(SwitchLatency &sl, uint64_t ns, uint64_t frames)
+{
+	auto &s = sl.stats;
+	s.switches++;
+	s.last_ns = ns;
+	s.total_ns += ns;
+	s.max_ns = std::max(s.max_ns, ns);
+	s.last_frames = frames;
+	s.last_origin = sl.switch_origin;
+	size_t bucket = 0;
+	while (bucket < SWITCH_LATENCY_BUCKETS - 1 && ns >= switch_latency_bucket_ms[bucket] * 1000000ULL)
+		bucket++;
+	s.buckets[bucket]++;
+}
+
+static void switch_latency_tick(void *, float)
+{
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	if (!switch_latency_pending)
+		return;
+	const uint64_t now = os_gettime_ns();
+	for (auto it = switch_latencies.begin(); it != switch_latencies.end();) {
+		auto &sl = it->second;
+		// the first tick after the switch starts the frame that renders it, the second runs once that frame is done
+		if (!sl.applied || ++sl.ticks < 2) {
+			++it;
+			continue;
+		}
+		auto canvas = obs_weak_canvas_get_canvas(sl.weak);
+		if (!canvas) {
+			it = switch_latencies.Erase(it);
+			continue;
+		}
+		sl.applied = false;
+		switch_latency_pending--;
+		auto frames = canvas_frames(canvas);
+		obs_canvas_release(canvas);
+		switch_latency_record(sl, now - sl.switch_ns, frames > sl.switch_frames ? frames - sl.switch_frames : 0);
+		++it;
+	}
+}
+
+static void switch_latency_transition_start(void *data, calldata_t *)
+{
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto sl = switch_latency_find_id(data);
+	if (!sl)
+		return;
+	auto canvas = obs_weak_canvas_get_canvas(sl->weak);
+	if (!canvas)
+		return;
+	sl->transition_start_ns = os_gettime_ns();
+	sl->transition_start_frames = canvas_frames(canvas);
+	obs_canvas_release(canvas);
+}
+
+static void switch_latency_transition_stop(void *data, calldata_t *)
+{
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto sl = switch_latency_find_id(data);
+	if (!sl || !sl->transition_start_ns)
+		return;
+	auto canvas = obs_weak_canvas_get_canvas(sl->weak);
+	if (!canvas)
+		return;
+	auto frames = canvas_frames(canvas);
+	obs_canvas_release(canvas);
+	sl->stats.transitions++;
+	sl->stats.last_transition_ns = os_gettime_ns() - sl->transition_start_ns;
+	sl->stats.last_transition_frames = frames > sl->transition_start_frames ? frames - sl->transition_start_frames : 0;
+	sl->transition_start_ns = 0;
+}
+
+void switch_latency_request(obs_canvas_t *canvas, const char *origin)
+{
+	if (!canvas)
+		return;
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto &sl = switch_latency_entry(canvas);
+	sl.request_ns = os_gettime_ns();
+	sl.request_frames = canvas_frames(canvas);
+	sl.request_origin = origin;
+}
+
+void switch_latency_cancel(obs_canvas_t *canvas)
+{
+	if (!canvas)
+		return;
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto sl = switch_latencies.Find(canvas);
+	if (sl)
+		sl->request_ns = 0;
+}
+
+void switch_latency_watch_transition(obs_canvas_t *canvas, obs_source_t *transition)
+{
+	if (!canvas || !transition)
+		return;
+	void *id;
+	{
+		std::lock_guard<std::mutex> lock(switch_latency_mutex);
+		id = (void *)switch_latency_entry(canvas).id;
+	}
+	auto sh = obs_source_get_signal_handler(transition);
+	signal_handler_disconnect(sh, "transition_start", switch_latency_transition_start, id);
+	signal_handler_disconnect(sh, "transition_stop", switch_latency_transition_stop, id);
+	signal_handler_connect(sh, "transition_start", switch_latency_transition_start, id);
+	signal_handler_connect(sh, "transition_stop", switch_latency_transition_stop, id);
+}
+
+void switch_latency_applied(obs_canvas_t *canvas)
+{
+	if (!canvas)
+		return;
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto &sl = switch_latency_entry(canvas);
+	const uint64_t now = os_gettime_ns();
+	if (sl.request_ns && now - sl.request_ns < SWITCH_LATENCY_REQUEST_TIMEOUT_NS) {
+		sl.switch_ns = sl.request_ns;
+		sl.switch_frames = sl.request_frames;
+		sl.switch_origin = sl.request_origin;
+	} else {
+		sl.switch_ns = now;
+		sl.switch_frames = canvas_frames(canvas);
+		sl.switch_origin = "other";
+	}
+	sl.request_ns = 0;
+	sl.ticks = 0;
+	if (!sl.applied) {
+		sl.applied = true;
+		switch_latency_pending++;
+	}
+	if (!switch_latency_ticking) {
+		switch_latency_ticking = true;
+		obs_add_tick_callback(switch_latency_tick, nullptr);
+	}
+}
+
+bool switch_latency_get_stats(obs_canvas_t *canvas, struct switch_latency_stats *stats)
+{
+	if (!canvas)
+		return false;
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	auto sl = switch_latencies.Find(canvas);
+	if (!sl || (!sl->stats.switches && !sl->stats.transitions))
+		return false;
+	*stats = sl->stats;
+	return true;
+}
+
+double switch_latency_percentile_ms(const struct switch_latency_stats *stats, double percentile)
+{
+	if (!stats->switches)
+		return 0.0;
+	const double max_ms = (double)stats->max_ns / 1000000.0;
+	const auto target = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile * (double)stats->switches));
+	uint64_t count = 0;
+	for (size_t i = 0; i < SWITCH_LATENCY_BUCKETS - 1; i++) {
+		count += stats->buckets[i];
+		if (count >= target)
+			return std::min((double)switch_latency_bucket_ms[i], max_ms);
+	}
+	return max_ms;
+}
+
+void switch_latency_reset(obs_canvas_t *canvas)
+{
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	for (auto &it : switch_latencies) {
+		if (!canvas || it.second.canvas == canvas)
+			it.second.stats = {};
+	}
+}
+
+void switch_latency_remove(obs_canvas_t *canvas)
+{
+	if (!canvas)
+		return;
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	switch_latencies.Remove(canvas);
+}
+
+void switch_latency_free_all()
+{
+	if (switch_latency_ticking) {
+		obs_remove_tick_callback(switch_latency_tick, nullptr);
+		switch_latency_ticking = false;
+	}
+	std::lock_guard<std::mutex> lock(switch_latency_mutex);
+	switch_latencies.Clear();
+	switch_latency_pending = 0;
+}
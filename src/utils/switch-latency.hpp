@@ -0,0 +1,34 @@
+#pragma once
+#include <obs.h>
+
+#define SWITCH_LATENCY_BUCKETS 10
+#define SWITCH_LATENCY_REQUEST_TIMEOUT_NS 5000000000ULL
+
+struct switch_latency_stats {
+	uint64_t switches;
+	uint64_t last_ns;
+	uint64_t max_ns;
+	uint64_t total_ns;
+	uint64_t last_frames;
+	const char *last_origin;
+	uint64_t buckets[SWITCH_LATENCY_BUCKETS];
+	uint64_t transitions;
+	uint64_t last_transition_ns;
+	uint64_t last_transition_frames;
+};
+
+// upper bound of each histogram bucket in ms, the last bucket is open ended
+extern const uint32_t switch_latency_bucket_ms[SWITCH_LATENCY_BUCKETS];
+
+// a switch is timed from the request (hotkey, list, websocket, linked main scene) until the first frame rendered
+// after the canvas channel or transition changed has finished, canvas frame counters are sampled at both ends
+void switch_latency_request(obs_canvas_t *canvas, const char *origin);
+void switch_latency_cancel(obs_canvas_t *canvas);
+void switch_latency_watch_transition(obs_canvas_t *canvas, obs_source_t *transition);
+void switch_latency_applied(obs_canvas_t *canvas);
+
+bool switch_latency_get_stats(obs_canvas_t *canvas, struct switch_latency_stats *stats);
+double switch_latency_percentile_ms(const struct switch_latency_stats *stats, double percentile);
+void switch_latency_reset(obs_canvas_t *canvas);
+void switch_latency_remove(obs_canvas_t *canvas);
+void switch_latency_free_all();
@@ -0,0 +1,92 @@
+#include "transition-pool.hpp"
+#include <algorithm>
+#include <cstring>
+
+static std::vector<OBSSource>::iterator find_source(std::vector<OBSSource> &list, obs_source_t *source)
+{
+	return std::find_if(list.begin(), list.end(), [source](const OBSSource &s) { return s.Get() == source; });
+}
+
+void TransitionPool::Rebuild()
+{
+	by_name.clear();
+	for (const auto &transition : transitions) {
+		const char *name = obs_source_get_name(transition);
+		by_name.emplace(name ? name : "", transition.Get());
+	}
+}
+
+void TransitionPool::Add(obs_source_t *transition)
+{
+	if (!transition)
+		return;
+	transitions.emplace_back(transition);
+	const char *name = obs_source_get_name(transition);
+	by_name.emplace(name ? name : "", transition);
+}
+
+void TransitionPool::Remove(obs_source_t *transition)
+{
+	auto it = find_source(transitions, transition);
+	if (it == transitions.end())
+		return;
+	Unprepare(transition);
+	transitions.erase(it);
+	Rebuild();
+}
+
+void TransitionPool::Clear()
+{
+	for (const auto &transition : prepared)
+		obs_source_dec_showing(transition);
+	prepared.clear();
+	transitions.clear();
+	by_name.clear();
+}
+
+obs_source_t *TransitionPool::Find(const char *name)
+{
+	if (!name || name[0] == '\0')
+		return nullptr;
+	auto it = by_name.find(name);
+	if (it != by_name.end()) {
+		const char *current = obs_source_get_name(it->second);
+		if (current && strcmp(current, name) == 0)
+			return it->second;
+	}
+	// transitions get renamed in place, rescan before reporting a miss
+	Rebuild();
+	it = by_name.find(name);
+	return it == by_name.end() ? nullptr : it->second;
+}
+
+void TransitionPool::Unprepare(obs_source_t *transition)
+{
+	auto it = find_source(prepared, transition);
+	if (it == prepared.end())
+		return;
+	obs_source_dec_showing(transition);
+	prepared.erase(it);
+}
+
+void TransitionPool::Prepare(const std::vector<std::string> &names, uint32_t cx, uint32_t cy)
+{
+	std::vector<obs_source_t *> wanted;
+	for (const auto &name : names) {
+		auto transition = Find(name.c_str());
+		if (transition && std::find(wanted.begin(), wanted.end(), transition) == wanted.end())
+			wanted.push_back(transition);
+	}
+	for (size_t i = prepared.size(); i > 0; i--) {
+		obs_source_t *transition = prepared[i - 1];
+		if (std::find(wanted.begin(), wanted.end(), transition) == wanted.end())
+			Unprepare(transition);
+	}
+	for (auto transition : wanted) {
+		obs_transition_set_size(transition, cx, cy);
+		if (find_source(prepared, transition) != prepared.end())
+			continue;
+		obs_source_inc_showing(transition);
+		prepared.emplace_back(transition);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <obs.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the transitions of one canvas in display order, looked up by name and with the scene override transitions kept showing
+class TransitionPool {
+private:
+	std::vector<OBSSource> transitions;
+	std::unordered_map<std::string, obs_source_t *> by_name;
+	std::vector<OBSSource> prepared;
+
+	void Rebuild();
+	void Unprepare(obs_source_t *transition);
+
+public:
+	~TransitionPool() { Clear(); }
+
+	std::vector<OBSSource>::const_iterator begin() const { return transitions.begin(); }
+	std::vector<OBSSource>::const_iterator end() const { return transitions.end(); }
+	size_t size() const { return transitions.size(); }
+
+	void Add(obs_source_t *transition);
+	void Remove(obs_source_t *transition);
+	void Clear();
+	obs_source_t *Find(const char *name);
+
+	// show the override transitions ahead of the cut so their media is loaded before first use
+	void Prepare(const std::vector<std::string> &names, uint32_t cx, uint32_t cy);
+};
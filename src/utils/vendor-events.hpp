@@ -0,0 +1,27 @@
+#pragma once
+#include <obs.h>
+
+enum vendor_event_category : uint32_t {
+	VENDOR_EVENT_SCENES = 1 << 0,
+	VENDOR_EVENT_SCENE_ITEMS = 1 << 1,
+	VENDOR_EVENT_OUTPUTS = 1 << 2,
+	VENDOR_EVENT_CANVAS = 1 << 3,
+	VENDOR_EVENT_DOCKS = 1 << 4,
+	VENDOR_EVENT_STATS = 1 << 5,
+};
+
+// the coarse events always go out so clients that never subscribe see no change, subscriptions only add to them
+#define VENDOR_EVENT_DEFAULT (VENDOR_EVENT_SCENES | VENDOR_EVENT_OUTPUTS | VENDOR_EVENT_CANVAS | VENDOR_EVENT_DOCKS)
+
+#define VENDOR_STATS_INTERVAL_MIN_MS 250
+#define VENDOR_STATS_INTERVAL_MAX_MS 60000
+
+// subscriptions lapse unless renewed within ttl_ms, vendor requests carry no session to drop them on disconnect
+#define VENDOR_SUBSCRIPTION_TTL_MS 300000
+#define VENDOR_SUBSCRIPTION_TTL_MAX_MS 3600000
+
+bool vendor_event_wanted(uint32_t category);
+void vendor_emit_event(uint32_t category, const char *event_name, obs_data_t *data);
+
+// smallest interval requested through subscribe_stats, 0 when nobody is subscribed
+uint32_t vendor_stats_interval();
@@ -1,9 +1,12 @@
 #include "capture-widget.hpp"
+#include "../properties-cache.hpp"
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QToolButton>
 #include <QMenu>
 #include <obs-module.h>
+#include <obs.hpp>
+#include <string>
 
 CaptureWidget::CaptureWidget(obs_source_t *s, QWidget *parent) : QFrame(parent), source(obs_source_get_weak_source(s))
 {
@@ -29,52 +32,52 @@ CaptureWidget::CaptureWidget(obs_source_t *s, QWidget *parent) : QFrame(parent),
 	button->setProperty("class", "icon-gear");
 
 	connect(button, &QToolButton::triggered, [this] {
-		auto s = obs_weak_source_get_source(source);
+		OBSSourceAutoRelease s = obs_weak_source_get_source(source);
 		if (!s)
 			return;
-		auto props = obs_source_properties(s);
-		obs_source_release(s);
-		if (!props)
-			return;
-
-		QMenu menu;
-
-		auto window = obs_properties_get(props, "window");
-		auto format = obs_property_list_format(window);
-		auto count = obs_property_list_item_count(window);
-		for (size_t i = 0; i < count; i++) {
-			auto desc = obs_property_list_item_name(window, i);
-			if (!desc || desc[0] == '\0')
-				continue;
-			if (format == OBS_COMBO_FORMAT_STRING) {
-				auto val = obs_property_list_item_string(window, i);
-				menu.addAction(QString::fromUtf8(desc), [this, val] {
-					auto s2 = obs_weak_source_get_source(source);
-					if (!s2)
-						return;
-					auto d = obs_data_create();
-					obs_data_set_string(d, "window", val);
-					obs_source_update(s2, d);
-					obs_data_release(d);
-					obs_source_release(s2);
-				});
-			} else if (format == OBS_COMBO_FORMAT_INT) {
-				auto val = obs_property_list_item_int(window, i);
-				menu.addAction(QString::fromUtf8(desc), [this, val] {
-					auto s2 = obs_weak_source_get_source(source);
-					if (!s2)
-						return;
-					auto d = obs_data_create();
-					obs_data_set_int(d, "window", val);
-					obs_source_update(s2, d);
-					obs_data_release(d);
-					obs_source_release(s2);
-				});
+		properties_cache_get(s, this, [this](std::shared_ptr<obs_properties_t> props) {
+			if (!props)
+				return;
+
+			QMenu menu;
+
+			auto window = obs_properties_get(props.get(), "window");
+			auto format = obs_property_list_format(window);
+			auto count = obs_property_list_item_count(window);
+			for (size_t i = 0; i < count; i++) {
+				auto desc = obs_property_list_item_name(window, i);
+				if (!desc || desc[0] == '\0')
+					continue;
+				if (format == OBS_COMBO_FORMAT_STRING) {
+					auto item = obs_property_list_item_string(window, i);
+					std::string val = item ? item : "";
+					menu.addAction(QString::fromUtf8(desc), [this, val] {
+						auto s2 = obs_weak_source_get_source(source);
+						if (!s2)
+							return;
+						auto d = obs_data_create();
+						obs_data_set_string(d, "window", val.c_str());
+						obs_source_update(s2, d);
+						obs_data_release(d);
+						obs_source_release(s2);
+					});
+				} else if (format == OBS_COMBO_FORMAT_INT) {
+					auto val = obs_property_list_item_int(window, i);
+					menu.addAction(QString::fromUtf8(desc), [this, val] {
+						auto s2 = obs_weak_source_get_source(source);
+						if (!s2)
+							return;
+						auto d = obs_data_create();
+						obs_data_set_int(d, "window", val);
+						obs_source_update(s2, d);
+						obs_data_release(d);
+						obs_source_release(s2);
+					});
+				}
 			}
-		}
 
-		menu.exec(QCursor::pos());
-		obs_properties_destroy(props);
+			menu.exec(QCursor::pos());
+		});
 	});
 
 	l2->addWidget(button);
@@ -11,10 +11,13 @@
 #include <QTime>
 #include <src/utils/color.hpp>
 #include <src/utils/icon.hpp>
-#include <src/utils/obs-websocket-api.h>
+#include <src/utils/registry.hpp>
+#include <src/utils/vendor-events.hpp>
 #include <util/config-file.h>
 #include <util/platform.h>
 
+#define BACKTRACK_SAVE_TIMEOUT_NS 10000000000ULL
+
 extern obs_data_t *current_profile_config;
 extern bool isTwitchServer(QString outputServer);
 
@@ -25,6 +28,7 @@ OutputWidget::OutputWidget(obs_data_t *output_data, QWidget *parent) : QFrame(pa
 	auto name = QString::fromUtf8(nameChars);
 
 	setObjectName(name);
+	registry_add_output(nameChars, this);
 
 	auto outputLayout = new QHBoxLayout;
 	outputLayout->setContentsMargins(5, 0, 5, 0);
@@ -172,12 +176,7 @@ OutputWidget::OutputWidget(obs_data_t *output_data, QWidget *parent) : QFrame(pa
 			"QPushButton:checked{background: rgb(26,87,255);} QPushButton{min-width: 32px; padding-left: 0px; padding-right: 0px; border-top-left-radius: 0; border-bottom-left-radius: 0;}"));
 		extraButton->setToolTip(QString::fromUtf8(obs_module_text("SaveBacktrack")));
 
-		connect(extraButton, &QPushButton::clicked, [this] {
-			calldata_t cd = {0};
-			proc_handler_t *ph = obs_output_get_proc_handler(this->output);
-			proc_handler_call(ph, "save", &cd);
-			calldata_free(&cd);
-		});
+		connect(extraButton, &QPushButton::clicked, [this] { SaveBacktrack(); });
 
 		connect(outputButton, &QPushButton::toggled, [this, replayEnable] {
 			bool enabled = outputButton->isChecked();
@@ -190,17 +189,7 @@ OutputWidget::OutputWidget(obs_data_t *output_data, QWidget *parent) : QFrame(pa
 		std::string ebDescription = obs_module_text("SaveBacktrack");
 		ebDescription = ebDescription + " " + nameChars;
 
-		extraHotkey = obs_hotkey_register_frontend(
-			ebName.c_str(), ebDescription.c_str(),
-			[](void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed) {
-				UNUSED_PARAMETER(id);
-				UNUSED_PARAMETER(hotkey);
-				if (!pressed)
-					return;
-				auto this_ = (OutputWidget *)data;
-				QMetaObject::invokeMethod(this_->extraButton, "click");
-			},
-			this);
+		extraHotkey = hotkey_dispatch_add_output(this, HotkeyAction::SaveBacktrack, ebName.c_str(), ebDescription.c_str());
 
 		auto extra_hotkey = obs_data_get_array(settings, "extra_hotkey");
 		obs_hotkey_load(extraHotkey, extra_hotkey);
@@ -285,33 +274,8 @@ OutputWidget::OutputWidget(obs_data_t *output_data, QWidget *parent) : QFrame(pa
 	std::string stopDescription = obs_module_text("StopHotkey");
 	stopDescription = stopDescription + " " + nameChars;
 
-	StartStopHotkey = obs_hotkey_pair_register_frontend(
-		startName.c_str(), startDescription.c_str(), stopName.c_str(), stopDescription.c_str(),
-		[](void *data, obs_hotkey_pair_id id, obs_hotkey_t *hotkey, bool pressed) {
-			UNUSED_PARAMETER(id);
-			UNUSED_PARAMETER(hotkey);
-			if (!pressed)
-				return false;
-			auto this_ = (OutputWidget *)data;
-			if (!this_->output || !obs_output_active(this_->output)) {
-				QMetaObject::invokeMethod(this_->outputButton, "click");
-				return true;
-			}
-			return false;
-		},
-		[](void *data, obs_hotkey_pair_id id, obs_hotkey_t *hotkey, bool pressed) {
-			UNUSED_PARAMETER(id);
-			UNUSED_PARAMETER(hotkey);
-			if (!pressed)
-				return false;
-			auto this_ = (OutputWidget *)data;
-			if (this_->output && obs_output_active(this_->output)) {
-				QMetaObject::invokeMethod(this_->outputButton, "click");
-				return true;
-			}
-			return false;
-		},
-		this, this);
+	StartStopHotkey = hotkey_dispatch_add_output_pair(this, startName.c_str(), startDescription.c_str(), stopName.c_str(),
+							  stopDescription.c_str());
 
 	auto start_hotkey = obs_data_get_array(output_data, "start_hotkey");
 	auto stop_hotkey = obs_data_get_array(output_data, "stop_hotkey");
@@ -325,14 +289,36 @@ OutputWidget::OutputWidget(obs_data_t *output_data, QWidget *parent) : QFrame(pa
 	});
 }
 
+bool OutputWidget::TriggerHotkey(HotkeyAction action)
+{
+	switch (action) {
+	case HotkeyAction::StartOutput:
+		if (output && obs_output_active(output))
+			return false;
+		QMetaObject::invokeMethod(outputButton, "click");
+		return true;
+	case HotkeyAction::StopOutput:
+		if (!output || !obs_output_active(output))
+			return false;
+		QMetaObject::invokeMethod(outputButton, "click");
+		return true;
+	case HotkeyAction::SaveBacktrack:
+		if (!extraButton)
+			return false;
+		QMetaObject::invokeMethod(extraButton, "click");
+		return true;
+	default:
+		return false;
+	}
+}
+
 OutputWidget::~OutputWidget()
 {
-	if (StartStopHotkey != OBS_INVALID_HOTKEY_PAIR_ID)
-		obs_hotkey_pair_unregister(StartStopHotkey);
+	auto name = objectName().toUtf8();
+	registry_remove_output(name.constData(), this);
+	hotkey_dispatch_remove_output(this);
 	if (PauseHotkey != OBS_INVALID_HOTKEY_PAIR_ID)
 		obs_hotkey_pair_unregister(PauseHotkey);
-	if (extraHotkey != OBS_INVALID_HOTKEY_ID)
-		obs_hotkey_unregister(extraHotkey);
 	if (splitHotkey != OBS_INVALID_HOTKEY_ID)
 		obs_hotkey_unregister(splitHotkey);
 	if (chapterHotkey != OBS_INVALID_HOTKEY_ID)
@@ -341,6 +327,8 @@ OutputWidget::~OutputWidget()
 		signal_handler_t *signal = obs_output_get_signal_handler(output);
 		signal_handler_disconnect(signal, "start", output_start, this);
 		signal_handler_disconnect(signal, "stop", output_stop, this);
+		if (extraButton)
+			signal_handler_disconnect(signal, "saved", replay_saved, this);
 		if (strcmp(obs_output_get_id(output), "virtualcam_output") == 0) {
 			obs_output_set_media(output, obs_get_video(), obs_get_audio());
 		}
@@ -352,12 +340,20 @@ OutputWidget::~OutputWidget()
 
 void OutputWidget::output_start(void *data, calldata_t *calldata)
 {
-	UNUSED_PARAMETER(calldata);
 	auto this_ = (OutputWidget *)data;
+	this_->activeSince = os_gettime_ns();
 	if (this_->onStarted) {
 		this_->onStarted();
 		this_->onStarted = nullptr;
 	}
+	if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
+		auto output = (obs_output_t *)calldata_ptr(calldata, "output");
+		const auto d = obs_data_create();
+		obs_data_set_string(d, "output", obs_output_get_name(output));
+		obs_data_set_string(d, "state", "active");
+		vendor_emit_event(VENDOR_EVENT_OUTPUTS, "output_state", d);
+		obs_data_release(d);
+	}
 	if (this_->outputButton->isChecked())
 		return;
 	QMetaObject::invokeMethod(this_->outputButton, [this_] { this_->outputButton->setChecked(true); }, Qt::QueuedConnection);
@@ -367,7 +363,16 @@ void OutputWidget::replay_saved(void *data, calldata_t *calldata)
 {
 	UNUSED_PARAMETER(calldata);
 	auto this_ = (OutputWidget *)data;
-	QMetaObject::invokeMethod(this_->extraButton, [this_] {
+	const uint64_t saved_at = os_gettime_ns();
+	BacktrackSave save = {0, 0, 0};
+	{
+		std::lock_guard<std::mutex> lock(this_->backtrackSaveMutex);
+		if (this_->BacktrackSaveTracked(saved_at))
+			save = this_->backtrackSave;
+		this_->backtrackSave = {0, 0, 0};
+	}
+	const uint64_t since = this_->activeSince;
+	QMetaObject::invokeMethod(this_->extraButton, [this_, save, since, saved_at] {
 		this_->startTime = QDateTime::currentDateTime();
 		proc_handler_t *ph = obs_output_get_proc_handler(this_->output);
 		if (!ph)
@@ -382,20 +387,39 @@ void OutputWidget::replay_saved(void *data, calldata_t *calldata)
 		calldata_free(&cd);
 		if (!path.isEmpty()) {
 			const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
-			if (!main_window) {
-				return;
-			}
-			QMetaObject::invokeMethod(main_window, "RecordingFileChanged", Q_ARG(QString, path));
+			if (main_window)
+				QMetaObject::invokeMethod(main_window, "RecordingFileChanged", Q_ARG(QString, path));
+		}
+		if (!vendor_event_wanted(VENDOR_EVENT_OUTPUTS))
+			return;
+		double duration = since && saved_at > since ? (double)(saved_at - since) / 1000000000.0 : 0.0;
+		auto max_sec = obs_data_get_int(this_->settings, "max_time_sec");
+		if (max_sec > 0 && duration > (double)max_sec)
+			duration = (double)max_sec;
+		const auto d = obs_data_create();
+		obs_data_set_string(d, "output", this_->objectName().toUtf8().constData());
+		obs_data_set_string(d, "path", path.toUtf8().constData());
+		if (save.id)
+			obs_data_set_int(d, "save_id", (long long)save.id);
+		obs_data_set_double(d, "duration_sec", duration);
+		if (save.trim_sec) {
+			obs_data_set_int(d, "trim_sec", save.trim_sec);
+			obs_data_set_double(d, "trim_start_sec", duration > save.trim_sec ? duration - save.trim_sec : 0.0);
 		}
+		vendor_emit_event(VENDOR_EVENT_OUTPUTS, "backtrack_saved", d);
+		obs_data_release(d);
 	});
 }
 
-extern obs_websocket_vendor vendor;
-
 void OutputWidget::output_stop(void *data, calldata_t *calldata)
 {
 	UNUSED_PARAMETER(calldata);
 	auto this_ = (OutputWidget *)data;
+	this_->activeSince = 0;
+	{
+		std::lock_guard<std::mutex> lock(this_->backtrackSaveMutex);
+		this_->backtrackSave = {0, 0, 0};
+	}
 	if (this_->onStarted) {
 		const char *last_error = (const char *)calldata_ptr(calldata, "last_error");
 		if (last_error)
@@ -424,16 +448,18 @@ void OutputWidget::output_stop(void *data, calldata_t *calldata)
 				if (this_->output && strcmp(obs_output_get_id(this_->output), "virtualcam_output") == 0) {
 					obs_output_set_media(this_->output, obs_get_video(), obs_get_audio());
 				}
+				std::string name = this_->output ? obs_output_get_name(this_->output) : "";
 				obs_output_release(this_->output);
 				this_->output = nullptr;
-				if (vendor) {
+				if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
 					const auto d = obs_data_create();
-					obs_data_set_string(d, "output", obs_output_get_name(this_->output));
+					obs_data_set_string(d, "output", name.c_str());
+					obs_data_set_string(d, "state", "stopped");
 					if (!last_error.empty())
 						obs_data_set_string(d, "last_error", last_error.c_str());
 					obs_data_set_int(d, "code", code);
 
-					obs_websocket_vendor_emit_event(vendor, "stop_output", d);
+					vendor_emit_event(VENDOR_EVENT_OUTPUTS, "stop_output", d);
 					obs_data_release(d);
 				}
 			},
@@ -498,11 +524,12 @@ bool OutputWidget::StartOutput(bool automated)
 			return false;
 		}
 		output = vco;
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "output", name);
 			obs_data_set_string(d, "canvas", obs_canvas_get_name(canvas));
-			obs_websocket_vendor_emit_event(vendor, "start_output", d);
+			obs_data_set_string(d, "state", "starting");
+			vendor_emit_event(VENDOR_EVENT_OUTPUTS, "start_output", d);
 			obs_data_release(d);
 		}
 		obs_canvas_release(canvas);
@@ -601,10 +628,11 @@ bool OutputWidget::StartOutput(bool automated)
 			return false;
 		}
 
-		if (vendor) {
+		if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
 			const auto d = obs_data_create();
 			obs_data_set_string(d, "output", name);
-			obs_websocket_vendor_emit_event(vendor, "start_output", d);
+			obs_data_set_string(d, "state", "starting");
+			vendor_emit_event(VENDOR_EVENT_OUTPUTS, "start_output", d);
 			obs_data_release(d);
 		}
 		return true;
@@ -984,10 +1012,11 @@ bool OutputWidget::StartOutput(bool automated)
 		output = nullptr;
 		return false;
 	}
-	if (vendor) {
+	if (vendor_event_wanted(VENDOR_EVENT_OUTPUTS)) {
 		const auto d = obs_data_create();
 		obs_data_set_string(d, "output", name);
-		obs_websocket_vendor_emit_event(vendor, "start_output", d);
+		obs_data_set_string(d, "state", "starting");
+		vendor_emit_event(VENDOR_EVENT_OUTPUTS, "start_output", d);
 		obs_data_release(d);
 	}
 	return true;
@@ -1393,6 +1422,56 @@ bool OutputWidget::AddChapter(const char *chapter_name)
 	return result;
 }
 
+bool OutputWidget::SaveBacktrack()
+{
+	if (!extraButton || !output)
+		return false;
+	// hold a reference so a concurrent output_stop cannot release the output under the save call
+	obs_output_t *o = obs_output_get_ref(output);
+	if (!o)
+		return false;
+	proc_handler_t *ph = obs_output_active(o) ? obs_output_get_proc_handler(o) : nullptr;
+	bool result = false;
+	if (ph) {
+		calldata_t cd = {0};
+		result = proc_handler_call(ph, "save", &cd);
+		calldata_free(&cd);
+	}
+	obs_output_release(o);
+	return result;
+}
+
+uint64_t OutputWidget::RequestBacktrackSave(uint32_t trim_sec)
+{
+	static std::atomic<uint64_t> last_save_id = 0;
+	const uint64_t id = ++last_save_id;
+	{
+		std::lock_guard<std::mutex> lock(backtrackSaveMutex);
+		const uint64_t now = os_gettime_ns();
+		if (BacktrackSaveTracked(now))
+			return 0;
+		backtrackSave = {id, trim_sec, now};
+	}
+	if (SaveBacktrack())
+		return id;
+	std::lock_guard<std::mutex> lock(backtrackSaveMutex);
+	if (backtrackSave.id == id)
+		backtrackSave = {0, 0, 0};
+	return 0;
+}
+
+// call with backtrackSaveMutex held
+bool OutputWidget::BacktrackSaveTracked(uint64_t now) const
+{
+	return backtrackSave.id && now - backtrackSave.requested_ns < BACKTRACK_SAVE_TIMEOUT_NS;
+}
+
+bool OutputWidget::BacktrackSavePending()
+{
+	std::lock_guard<std::mutex> lock(backtrackSaveMutex);
+	return BacktrackSaveTracked(os_gettime_ns());
+}
+
 bool OutputWidget::StartOutput(std::function<void()> onStarted)
 {
 	if (output && obs_output_active(output)) {
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <obs.h>
+#include <src/utils/hotkey-dispatch.hpp>
 #include <QFrame>
 #include <QLabel>
 #include <QPushButton>
@@ -22,6 +25,17 @@ private:
 
 	QTimer activeTimer;
 	QDateTime startTime;
+	std::atomic<uint64_t> activeSince = 0;
+
+	struct BacktrackSave {
+		uint64_t id;
+		uint32_t trim_sec;
+		uint64_t requested_ns;
+	};
+	// libobs merges saves requested before the previous one is written, so only one websocket save is matched to its
+	// saved signal at a time, and it lapses after BACKTRACK_SAVE_TIMEOUT_NS in case that signal never comes
+	std::mutex backtrackSaveMutex;
+	BacktrackSave backtrackSave = {0, 0, 0};
 
 	obs_hotkey_pair_id StartStopHotkey = OBS_INVALID_HOTKEY_PAIR_ID;
 	obs_hotkey_pair_id PauseHotkey = OBS_INVALID_HOTKEY_PAIR_ID;
@@ -30,6 +44,7 @@ private:
 	obs_hotkey_id chapterHotkey = OBS_INVALID_HOTKEY_ID;
 
 	bool StartOutput(bool automated = false);
+	bool BacktrackSaveTracked(uint64_t now) const;
 	void UpdateCanvas();
 	obs_encoder_t *GetVideoEncoder(obs_data_t *settings, bool advanced, bool is_record, const char *output_name,
 				       bool automated);
@@ -50,9 +65,15 @@ public:
 	void SaveSettings();
 	void UpdateSettings(obs_data_t *data);
 	bool AddChapter(const char *chapter_name);
+	bool SaveBacktrack();
+	// saves and returns an id the backtrack_saved event repeats, 0 when the save failed or another one is tracked
+	uint64_t RequestBacktrackSave(uint32_t trim_sec);
+	bool BacktrackSavePending();
 	bool StartOutput(std::function<void()> onStarted);
 	void StopOutput();
 	bool IsStream() const;
 	bool IsRecord() const;
 	const char* GetOutputType() const;
+	// runs the action its hotkeys and the websocket requests map to, safe from any thread
+	bool TriggerHotkey(HotkeyAction action);
 };
@@ -5,6 +5,7 @@
 #include <QScreen>
 #include <QWindow>
 #include "projector.hpp"
+#include "../preview-texture.hpp"
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <util/config-file.h>
@@ -191,7 +192,7 @@ void OBSProjector::OBSRender(void *data, uint32_t cx, uint32_t cy)
 	startRegion(x, y, newCX, newCY, 0.0f, float(targetCX), 0.0f, float(targetCY));
 
 	if (canvas) {
-		obs_canvas_render(canvas);
+		preview_texture_draw(canvas, targetCX, targetCY);
 	} else if (source) {
 		obs_source_video_render(source);
 	}
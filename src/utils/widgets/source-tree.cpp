@@ -5,21 +5,22 @@
 #include <obs.h>
 #include <obs-frontend-api.h>
 #include <QAccessible>
-#include <QHBoxLayout>
-#include <QLabel>
 #include <QLineEdit>
 #include <QMainWindow>
 #include <QMessageBox>
 #include <QMouseEvent>
 #include <QPushButton>
-#include <QSpacerItem>
+#include <QStyleOptionButton>
 #include <QStyleOptionFocusRect>
 #include <QStylePainter>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <src/docks/canvas-dock.hpp>
 #include <src/utils/icon.hpp>
+#include <algorithm>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -28,556 +29,139 @@
 
 /* ========================================================================= */
 
-SourceTreeItem::SourceTreeItem(SourceTree *tree_, OBSSceneItem sceneitem_) : tree(tree_), sceneitem(sceneitem_)
-{
-	setAttribute(Qt::WA_TranslucentBackground);
-	setMouseTracking(true);
-
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	const char *name = obs_source_get_name(source);
-
-	OBSDataAutoRelease privData = obs_sceneitem_get_private_settings(sceneitem);
-	int preset = (int)obs_data_get_int(privData, "color-preset");
-
-	if (preset == 1) {
-		const char *color = obs_data_get_string(privData, "color");
-		std::string col = "background: ";
-		col += color;
-		setStyleSheet(col.c_str());
-	} else if (preset > 1) {
-		setStyleSheet("");
-		setProperty("bgColor", preset - 1);
-	} else {
-		setStyleSheet("background: none");
-	}
-
-	//OBSBasic *main = reinterpret_cast<OBSBasic *>(App()->GetMainWindow());
-	const char *id = obs_source_get_id(source);
-
-	bool sourceVisible = obs_sceneitem_visible(sceneitem);
-
-	if (tree->iconsVisible) {
-		QIcon icon;
-
-		if (strcmp(id, "scene") == 0)
-			icon = GetSceneIcon();
-		else if (strcmp(id, "group") == 0)
-			icon = GetGroupIcon();
-		else
-			icon = GetIconFromType(obs_source_get_icon_type(id));
-
-		QPixmap pixmap = icon.pixmap(QSize(16, 16));
-
-		iconLabel = new QLabel();
-		iconLabel->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
-		iconLabel->setPixmap(pixmap);
-		iconLabel->setEnabled(sourceVisible);
-		iconLabel->setStyleSheet("background: none");
-		iconLabel->setProperty("class", "source-icon");
-	}
-
-	vis = new VisibilityCheckBox();
-	vis->setProperty("class", "checkbox-icon indicator-visibility");
-	vis->setChecked(sourceVisible);
-	vis->setStyleSheet("background: none");
-	vis->setAccessibleName(QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.Sources.Visibility")));
-	vis->setAccessibleDescription(
-		QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.Sources.VisibilityDescription")).arg(name));
-	vis->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Preferred);
-
-	lock = new LockedCheckBox();
-	lock->setProperty("class", "checkbox-icon indicator-lock");
-	lock->setChecked(obs_sceneitem_locked(sceneitem));
-	lock->setStyleSheet("background: none");
-	lock->setAccessibleName(QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.Sources.Lock")));
-	lock->setAccessibleDescription(
-		QString::fromUtf8(obs_frontend_get_locale_string("Basic.Main.Sources.LockDescription")).arg(name));
-	lock->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Preferred);
-
-	label = new QLabel(QString::fromUtf8(name));
-	label->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Preferred);
-	label->setAttribute(Qt::WA_TranslucentBackground);
-	label->setEnabled(sourceVisible);
-
-#ifdef __APPLE__
-	vis->setAttribute(Qt::WA_LayoutUsesWidgetRect);
-	lock->setAttribute(Qt::WA_LayoutUsesWidgetRect);
-#endif
-
-	boxLayout = new QHBoxLayout();
-
-	boxLayout->setContentsMargins(0, 0, 0, 0);
-	if (iconLabel) {
-		boxLayout->addWidget(iconLabel);
-		boxLayout->addSpacing(2);
-	}
-	boxLayout->addWidget(label);
-	boxLayout->addWidget(vis);
-	boxLayout->addWidget(lock);
-#ifdef __APPLE__
-	/* Hack: Fixes a bug where scrollbars would be above the lock icon */
-	boxLayout->addSpacing(16);
-#endif
-
-	Update(false);
-
-	setLayout(boxLayout);
-
-	/* --------------------------------------------------------- */
-
-	auto setItemVisible = [this](bool val) {
-		const bool blocked = blockSignals(true);
-		obs_sceneitem_set_visible(sceneitem, val);
-		blockSignals(blocked);
-	};
-
-	auto setItemLocked = [this](bool checked) {
-		const bool blocked = blockSignals(true);
-		obs_sceneitem_set_locked(sceneitem, checked);
-		blockSignals(blocked);
-	};
-
-	connect(vis, &QAbstractButton::clicked, setItemVisible);
-	connect(lock, &QAbstractButton::clicked, setItemLocked);
-}
-
-SourceTreeItem::~SourceTreeItem()
-{
-	DisconnectSignals();
-}
-
-void SourceTreeItem::paintEvent(QPaintEvent *event)
-{
-	QStyleOption opt;
-	opt.initFrom(this);
-	QPainter p(this);
-	style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
-
-	QWidget::paintEvent(event);
-}
-
-void SourceTreeItem::DisconnectSignals()
-{
-	sigs.clear();
-}
-
-void SourceTreeItem::Clear()
-{
-	DisconnectSignals();
-	sceneitem = nullptr;
-}
 extern std::list<CanvasDock *> canvas_docks;
 extern CanvasDock *component_dock;
 
-void SourceTreeItem::removeScene(void *data, calldata_t *)
+void SourceTreeModel::removeScene(void *data, calldata_t *)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	QMetaObject::invokeMethod(this_, "Clear");
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
+	QMetaObject::invokeMethod(this_, [this_] { this_->DisconnectSignals(); }, Qt::QueuedConnection);
 }
 
-void SourceTreeItem::removeItem(void *data, calldata_t *cd)
+void SourceTreeModel::removeItem(void *data, calldata_t *cd)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	if (!this_->tree)
-		return;
-	obs_sceneitem_t *curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
-	obs_scene_t *curScene = (obs_scene_t *)calldata_ptr(cd, "scene");
-	if (curItem == this_->sceneitem) {
-		QMetaObject::invokeMethod(this_->tree, "Remove", Q_ARG(OBSSceneItem, curItem), Q_ARG(OBSScene, curScene));
-		QMetaObject::invokeMethod(this_, "Clear");
-	}
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
+	OBSSceneItem curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
+	OBSScene curScene = (obs_scene_t *)calldata_ptr(cd, "scene");
+	QMetaObject::invokeMethod(
+		this_,
+		[this_, curItem, curScene] {
+			if (this_->items.indexOf(curItem) != -1)
+				this_->st->Remove(curItem, curScene);
+		},
+		Qt::QueuedConnection);
 }
 
-void SourceTreeItem::itemVisible(void *data, calldata_t *cd)
+void SourceTreeModel::itemChanged(void *data, calldata_t *cd)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
 	obs_sceneitem_t *curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
-	bool visible = calldata_bool(cd, "visible");
-
-	if (curItem == this_->sceneitem)
-		QMetaObject::invokeMethod(this_, "VisibilityChanged", Qt::QueuedConnection, Q_ARG(bool, visible));
+	QMetaObject::invokeMethod(this_, [this_, curItem] { this_->UpdateItem(curItem); }, Qt::QueuedConnection);
 }
 
-void SourceTreeItem::itemLocked(void *data, calldata_t *cd)
+void SourceTreeModel::itemSelect(void *data, calldata_t *cd)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
 	obs_sceneitem_t *curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
-	bool locked = calldata_bool(cd, "locked");
-
-	if (curItem == this_->sceneitem)
-		QMetaObject::invokeMethod(this_, "LockedChanged", Qt::QueuedConnection, Q_ARG(bool, locked));
+	QMetaObject::invokeMethod(this_, [this_, curItem] { this_->st->SelectItem(curItem, true); }, Qt::QueuedConnection);
 }
 
-void SourceTreeItem::itemSelect(void *data, calldata_t *cd)
+void SourceTreeModel::itemDeselect(void *data, calldata_t *cd)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
 	obs_sceneitem_t *curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
-
-	if (curItem == this_->sceneitem)
-		QMetaObject::invokeMethod(this_, "Select", Qt::QueuedConnection);
+	QMetaObject::invokeMethod(this_, [this_, curItem] { this_->st->SelectItem(curItem, false); }, Qt::QueuedConnection);
 }
 
-void SourceTreeItem::itemDeselect(void *data, calldata_t *cd)
+void SourceTreeModel::reorderGroup(void *data, calldata_t *)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	obs_sceneitem_t *curItem = (obs_sceneitem_t *)calldata_ptr(cd, "item");
-
-	if (curItem == this_->sceneitem)
-		QMetaObject::invokeMethod(this_, "Deselect", Qt::QueuedConnection);
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
+	QMetaObject::invokeMethod(this_->st, "ReorderItems", Qt::QueuedConnection);
 }
 
-void SourceTreeItem::reorderGroup(void *data, calldata_t *)
+void SourceTreeModel::sourceChanged(void *data, calldata_t *cd)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	QMetaObject::invokeMethod(this_->tree, "ReorderItems", Qt::QueuedConnection);
-};
-
-void SourceTreeItem::renamed(void *data, calldata_t *cd)
-{
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	const char *name = calldata_string(cd, "new_name");
-
-	QMetaObject::invokeMethod(this_, "Renamed", Qt::QueuedConnection, Q_ARG(QString, QString::fromUtf8(name)));
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
+	obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+	QMetaObject::invokeMethod(this_, [this_, source] { this_->UpdateSource(source); }, Qt::QueuedConnection);
 }
 
-void SourceTreeItem::removeSource(void *data, calldata_t *)
+void SourceTreeModel::removeSource(void *data, calldata_t *)
 {
-	SourceTreeItem *this_ = reinterpret_cast<SourceTreeItem *>(data);
-	this_->DisconnectSignals();
-	this_->sceneitem = nullptr;
-	QMetaObject::invokeMethod(this_->tree, "RefreshItems", Qt::QueuedConnection);
+	SourceTreeModel *this_ = reinterpret_cast<SourceTreeModel *>(data);
+	QMetaObject::invokeMethod(this_->st, "RefreshItems", Qt::QueuedConnection);
 }
 
-void SourceTreeItem::ReconnectSignals()
+void SourceTreeModel::ConnectSceneSignals(obs_scene_t *scene)
 {
-	if (!sceneitem)
+	if (!scene || !signalScenes.insert(scene).second)
 		return;
 
-	DisconnectSignals();
-
-	obs_scene_t *scene = obs_sceneitem_get_scene(sceneitem);
-	obs_source_t *sceneSource = obs_scene_get_source(scene);
-	signal_handler_t *signal = obs_source_get_signal_handler(sceneSource);
-	sigs.emplace_back(signal, "remove", removeScene, this);
+	signal_handler_t *signal = obs_source_get_signal_handler(obs_scene_get_source(scene));
 	sigs.emplace_back(signal, "item_remove", removeItem, this);
-	sigs.emplace_back(signal, "item_visible", itemVisible, this);
-	sigs.emplace_back(signal, "item_locked", itemLocked, this);
+	sigs.emplace_back(signal, "item_visible", itemChanged, this);
+	sigs.emplace_back(signal, "item_locked", itemChanged, this);
 	sigs.emplace_back(signal, "item_select", itemSelect, this);
 	sigs.emplace_back(signal, "item_deselect", itemDeselect, this);
-
-	if (obs_sceneitem_is_group(sceneitem)) {
-		obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-		signal = obs_source_get_signal_handler(source);
-
-		sigs.emplace_back(signal, "reorder", reorderGroup, this);
-	}
-
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	signal = obs_source_get_signal_handler(source);
-	sigs.emplace_back(signal, "rename", renamed, this);
-	sigs.emplace_back(signal, "remove", removeSource, this);
-}
-
-void SourceTreeItem::mouseDoubleClickEvent(QMouseEvent *event)
-{
-	QWidget::mouseDoubleClickEvent(event);
-
-	if (expand) {
-		expand->setChecked(!expand->isChecked());
-	} else {
-		obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-		if (source) {
-#if defined(_WIN32)
-			/* This timer works around a bug introduced around Qt 6.8.3 that causes
-			 * the application to hang when double clicking the sources list and the
-			 * Windows setting 'Snap mouse to default button in dialog boxes' is enabled.
-			 */
-			BOOL snapEnabled = FALSE;
-			SystemParametersInfo(SPI_GETSNAPTODEFBUTTON, 0, &snapEnabled, 0);
-
-			if (snapEnabled) {
-				QTimer::singleShot(200, this, [source]() { obs_frontend_open_source_properties(source); });
-			} else {
-				obs_frontend_open_source_properties(source);
-			}
-#else
-			obs_frontend_open_source_properties(source);
-#endif
-		}
-	}
-}
-
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-void SourceTreeItem::enterEvent(QEnterEvent *event)
-#else
-void SourceTreeItem::enterEvent(QEvent *event)
-#endif
-{
-	QWidget::enterEvent(event);
-
-	//OBSBasicPreview *preview = OBSBasicPreview::Get();
-
-	std::lock_guard<std::mutex> l(*tree->selectMutex);
-	tree->hoveredPreviewItems->clear();
-	tree->hoveredPreviewItems->push_back(sceneitem);
-}
-
-void SourceTreeItem::leaveEvent(QEvent *event)
-{
-	QWidget::leaveEvent(event);
-
-	std::lock_guard<std::mutex> l(*tree->selectMutex);
-	tree->hoveredPreviewItems->clear();
 }
 
-bool SourceTreeItem::IsEditing()
+void SourceTreeModel::ConnectSignals(obs_sceneitem_t *item)
 {
-	return editor != nullptr;
-}
+	ConnectSceneSignals(obs_sceneitem_get_scene(item));
 
-void SourceTreeItem::EnterEditMode()
-{
-	setFocusPolicy(Qt::StrongFocus);
-	int index = boxLayout->indexOf(label);
-	boxLayout->removeWidget(label);
-	editor = new QLineEdit(label->text());
-	editor->setStyleSheet("background: none");
-	editor->selectAll();
-	editor->installEventFilter(this);
-	boxLayout->insertWidget(index, editor);
-	setFocusProxy(editor);
-}
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	if (!source || !signalSources.insert(source).second)
+		return;
 
-void SourceTreeItem::ExitEditMode(bool save)
-{
-	ExitEditModeInternal(save);
+	signal_handler_t *signal = obs_source_get_signal_handler(source);
+	sigs.emplace_back(signal, "rename", sourceChanged, this);
+	sigs.emplace_back(signal, "remove", removeSource, this);
+	if (obs_sceneitem_is_group(item))
+		sigs.emplace_back(signal, "reorder", reorderGroup, this);
 }
 
-void SourceTreeItem::ExitEditModeInternal(bool save)
+void SourceTreeModel::ReconnectSignals()
 {
-	if (!editor) {
-		return;
-	}
-
-	newName = editor->text().toUtf8().constData();
-
-	setFocusProxy(nullptr);
-	int index = boxLayout->indexOf(editor);
-	boxLayout->removeWidget(editor);
-	delete editor;
-	editor = nullptr;
-	setFocusPolicy(Qt::NoFocus);
-	boxLayout->insertWidget(index, label);
-	label->setFocus();
-
-	/* ----------------------------------------- */
-	/* check for empty string                    */
-
-	if (!save)
-		return;
-
-	if (newName.empty()) {
-		QMessageBox::information(tree, QString::fromUtf8(obs_frontend_get_locale_string("NoNameEntered.Title")),
-					 QString::fromUtf8(obs_frontend_get_locale_string("NoNameEntered.Text")));
-		return;
-	}
-
-	/* ----------------------------------------- */
-	/* Check for same name                       */
-
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	if (newName == obs_source_get_name(source))
-		return;
-
-	/* ----------------------------------------- */
-	/* check for existing source                 */
-	obs_canvas_t *canvas = (obs_source_get_output_flags(source) & OBS_SOURCE_REQUIRES_CANVAS) ? obs_source_get_canvas(source)
-												  : nullptr;
-	OBSSourceAutoRelease existingSource = canvas ? obs_canvas_get_source_by_name(canvas, newName.c_str())
-						     : obs_get_source_by_name(newName.c_str());
-	bool exists = !!existingSource;
+	DisconnectSignals();
 
-	if (exists) {
-		QMessageBox::information(tree, QString::fromUtf8(obs_frontend_get_locale_string("NameExists.Title")),
-					 QString::fromUtf8(obs_frontend_get_locale_string("NameExists.Text")));
+	obs_scene_t *scene = st->getScene(st->getSceneParam);
+	if (!scene)
 		return;
-	}
 
-	/* ----------------------------------------- */
-	/* rename                                    */
+	ConnectSceneSignals(scene);
+	sigs.emplace_back(obs_source_get_signal_handler(obs_scene_get_source(scene)), "remove", removeScene, this);
 
-	const bool blocked = blockSignals(true);
-	obs_source_set_name(source, newName.c_str());
-	label->setText(QString::fromUtf8(newName.c_str()));
-	blockSignals(blocked);
+	for (auto &item : items)
+		ConnectSignals(item);
 }
 
-bool LineEditCanceled(QEvent *event)
+void SourceTreeModel::DisconnectSignals()
 {
-	if (event->type() == QEvent::KeyPress) {
-		QKeyEvent *keyEvent = reinterpret_cast<QKeyEvent *>(event);
-		return keyEvent->key() == Qt::Key_Escape;
-	}
-
-	return false;
+	sigs.clear();
+	signalScenes.clear();
+	signalSources.clear();
 }
 
-bool LineEditChanged(QEvent *event)
+void SourceTreeModel::UpdateItem(obs_sceneitem_t *item)
 {
-	if (event->type() == QEvent::KeyPress) {
-		QKeyEvent *keyEvent = reinterpret_cast<QKeyEvent *>(event);
-
-		switch (keyEvent->key()) {
-		case Qt::Key_Tab:
-		case Qt::Key_Backtab:
-		case Qt::Key_Enter:
-		case Qt::Key_Return:
-			return true;
+	for (int i = 0; i < items.count(); i++) {
+		if (items[i] == item) {
+			QModelIndex index = createIndex(i, 0);
+			emit dataChanged(index, index);
 		}
-	} else if (event->type() == QEvent::FocusOut) {
-		return true;
 	}
-
-	return false;
 }
 
-bool SourceTreeItem::eventFilter(QObject *object, QEvent *event)
+void SourceTreeModel::UpdateSource(obs_source_t *source)
 {
-	if (editor != object)
-		return false;
-
-	if (LineEditCanceled(event)) {
-		QMetaObject::invokeMethod(this, "ExitEditMode", Qt::QueuedConnection, Q_ARG(bool, false));
-		return true;
-	}
-	if (LineEditChanged(event)) {
-		QMetaObject::invokeMethod(this, "ExitEditMode", Qt::QueuedConnection, Q_ARG(bool, true));
-		return true;
-	}
-
-	return false;
-}
-
-void SourceTreeItem::VisibilityChanged(bool visible)
-{
-	if (iconLabel) {
-		iconLabel->setEnabled(visible);
-	}
-	label->setEnabled(visible);
-	vis->setChecked(visible);
-}
-
-void SourceTreeItem::LockedChanged(bool locked)
-{
-	lock->setChecked(locked);
-	//OBSBasic::Get()->UpdateEditMenu();
-}
-
-void SourceTreeItem::Renamed(const QString &name)
-{
-	label->setText(name);
-}
-
-void SourceTreeItem::Update(bool force)
-{
-	obs_scene_t *scene = tree->getScene(tree->getSceneParam);
-	obs_scene_t *itemScene = obs_sceneitem_get_scene(sceneitem);
-
-	Type newType;
-
-	/* ------------------------------------------------- */
-	/* if it's a group item, insert group checkbox       */
-
-	if (obs_sceneitem_is_group(sceneitem)) {
-		newType = Type::Group;
-
-		/* ------------------------------------------------- */
-		/* if it's a group sub-item                          */
-
-	} else if (itemScene != scene) {
-		newType = Type::SubItem;
-
-		/* ------------------------------------------------- */
-		/* if it's a regular item                            */
-
-	} else {
-		newType = Type::Item;
-	}
-
-	/* ------------------------------------------------- */
-
-	if (!force && newType == type) {
-		return;
-	}
-
-	/* ------------------------------------------------- */
-
-	ReconnectSignals();
-
-	if (spacer) {
-		boxLayout->removeItem(spacer);
-		delete spacer;
-		spacer = nullptr;
-	}
-
-	if (type == Type::Group) {
-		boxLayout->removeWidget(expand);
-		expand->deleteLater();
-		expand = nullptr;
-	}
-
-	type = newType;
-
-	if (type == Type::SubItem) {
-		spacer = new QSpacerItem(16, 1);
-		boxLayout->insertItem(0, spacer);
-
-	} else if (type == Type::Group) {
-		expand = new SourceTreeSubItemCheckBox();
-		expand->setProperty("class", "checkbox-icon indicator-expand");
-		expand->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
-#ifdef __APPLE__
-		expand->setAttribute(Qt::WA_LayoutUsesWidgetRect);
-#endif
-		boxLayout->insertWidget(0, expand);
-
-		OBSDataAutoRelease private_settings = obs_sceneitem_get_private_settings(sceneitem);
-		expand->blockSignals(true);
-		expand->setChecked(obs_data_get_bool(private_settings, "collapsed"));
-		expand->blockSignals(false);
-
-		connect(expand, &QPushButton::toggled, this, &SourceTreeItem::ExpandClicked);
-
-	} else {
-		spacer = new QSpacerItem(3, 1);
-		boxLayout->insertItem(0, spacer);
+	for (int i = 0; i < items.count(); i++) {
+		if (obs_sceneitem_get_source(items[i]) == source) {
+			QModelIndex index = createIndex(i, 0);
+			emit dataChanged(index, index);
+		}
 	}
 }
 
-void SourceTreeItem::ExpandClicked(bool checked)
-{
-	OBSDataAutoRelease private_settings = obs_sceneitem_get_private_settings(sceneitem);
-
-	obs_data_set_bool(private_settings, "collapsed", checked);
-
-	if (!checked)
-		tree->GetStm()->ExpandGroup(sceneitem);
-	else
-		tree->GetStm()->CollapseGroup(sceneitem);
-}
-
-void SourceTreeItem::Select()
-{
-	tree->SelectItem(sceneitem, true);
-}
-
-void SourceTreeItem::Deselect()
-{
-	tree->SelectItem(sceneitem, false);
-}
-
-/* ========================================================================= */
-
 void SourceTreeModel::OBSFrontendEvent(enum obs_frontend_event event, void *ptr)
 {
 	SourceTreeModel *stm = reinterpret_cast<SourceTreeModel *>(ptr);
@@ -588,6 +172,8 @@ void SourceTreeModel::OBSFrontendEvent(enum obs_frontend_event event, void *ptr)
 		break;
 	case OBS_FRONTEND_EVENT_EXIT:
 	case OBS_FRONTEND_EVENT_SCRIPTING_SHUTDOWN:
+		stm->DisconnectSignals();
+		stm->itemsScene = nullptr;
 		if (!stm->items.isEmpty())
 			stm->items.clear();
 		break;
@@ -601,6 +187,8 @@ void SourceTreeModel::OBSFrontendEvent(enum obs_frontend_event event, void *ptr)
 
 void SourceTreeModel::Clear()
 {
+	DisconnectSignals();
+	itemsScene = nullptr;
 	if (items.isEmpty())
 		return;
 	beginResetModel();
@@ -637,20 +225,32 @@ static bool enumItem(obs_scene_t *, obs_sceneitem_t *item, void *ptr)
 void SourceTreeModel::SceneChanged()
 {
 	obs_scene_t *scene = st->getScene(st->getSceneParam);
+	obs_source_t *sceneSource = obs_scene_get_source(scene);
 
-	beginResetModel();
-	items.clear();
-	obs_scene_enum_items(scene, enumItem, &items);
-	endResetModel();
+	if (sceneSource && itemsScene && obs_weak_source_references_source(itemsScene, sceneSource)) {
+		QVector<OBSSceneItem> newitems;
+		obs_scene_enum_items(scene, enumItem, &newitems);
+		ApplyItems(newitems);
+	} else {
+		itemsScene = OBSGetWeakRef(sceneSource);
 
-	UpdateGroupState(false);
-	st->ResetWidgets();
+		DisconnectSignals();
+		beginResetModel();
+		items.clear();
+		obs_scene_enum_items(scene, enumItem, &items);
+		endResetModel();
+
+		UpdateGroupState(false);
+		ReconnectSignals();
+	}
 
 	for (int i = 0; i < items.count(); i++) {
 		bool select = obs_sceneitem_selected(items[i]);
 		QModelIndex index = createIndex(i, 0);
 
-		st->selectionModel()->select(index, select ? QItemSelectionModel::Select : QItemSelectionModel::Deselect);
+		if (st->selectionModel()->isSelected(index) != select)
+			st->selectionModel()->select(index,
+						     select ? QItemSelectionModel::Select : QItemSelectionModel::Deselect);
 	}
 }
 
@@ -662,81 +262,73 @@ static inline void MoveItem(QVector<OBSSceneItem> &items, int oldIdx, int newIdx
 	items.insert(newIdx, item);
 }
 
-/* reorders list optimally with model reorder funcs */
-void SourceTreeModel::ReorderItems()
+/* turns the current rows into newitems with the fewest removes, moves and inserts,
+ * rows in the longest run that is already in the right order never move */
+void SourceTreeModel::ApplyItems(const QVector<OBSSceneItem> &newitems)
 {
-	obs_scene_t *scene = st->getScene(st->getSceneParam);
-
-	QVector<OBSSceneItem> newitems;
-	obs_scene_enum_items(scene, enumItem, &newitems);
+	DisconnectSignals();
 
-	/* if item list has changed size, do full reset */
-	if (newitems.count() != items.count()) {
-		SceneChanged();
-		return;
+	std::unordered_map<obs_sceneitem_t *, int> newIndices;
+	newIndices.reserve(newitems.size());
+	for (int i = 0; i < newitems.count(); i++)
+		newIndices[newitems[i]] = i;
+
+	for (int i = (int)items.count() - 1; i >= 0; i--) {
+		if (newIndices.count(items[i]))
+			continue;
+		int last = i;
+		while (i > 0 && !newIndices.count(items[i - 1]))
+			i--;
+		beginRemoveRows(QModelIndex(), i, last);
+		items.remove(i, last - i + 1);
+		endRemoveRows();
 	}
 
-	for (;;) {
-		int idx1Old = 0;
-		int idx1New = 0;
-		int count;
-		int i;
-
-		/* find first starting changed item index */
-		for (i = 0; i < newitems.count(); i++) {
-			obs_sceneitem_t *oldItem = items[i];
-			obs_sceneitem_t *newItem = newitems[i];
-			if (oldItem != newItem) {
-				idx1Old = i;
-				break;
-			}
-		}
-
-		/* if everything is the same, break */
-		if (i == newitems.count()) {
-			break;
-		}
-
-		/* find new starting index */
-		for (i = idx1Old + 1; i < newitems.count(); i++) {
-			obs_sceneitem_t *oldItem = items[idx1Old];
-			obs_sceneitem_t *newItem = newitems[i];
-
-			if (oldItem == newItem) {
-				idx1New = i;
-				break;
-			}
-		}
+	const int count = (int)items.count();
+	std::vector<int> positions(count);
+	std::vector<int> previous(count, -1);
+	std::vector<int> tails;
+	for (int i = 0; i < count; i++) {
+		positions[i] = newIndices[items[i]];
+		auto it = std::lower_bound(tails.begin(), tails.end(), positions[i],
+					   [&positions](int idx, int position) { return positions[idx] < position; });
+		if (it != tails.begin())
+			previous[i] = *(it - 1);
+		if (it == tails.end())
+			tails.push_back(i);
+		else
+			*it = i;
+	}
 
-		/* if item could not be found, do full reset */
-		if (i == newitems.count()) {
-			SceneChanged();
-			return;
+	std::unordered_set<obs_sceneitem_t *> stable;
+	for (int i = tails.empty() ? -1 : tails.back(); i != -1; i = previous[i])
+		stable.insert(items[i]);
+
+	for (int i = 0; i < newitems.count(); i++) {
+		obs_sceneitem_t *item = newitems[i];
+		if (stable.count(item))
+			continue;
+
+		int target = i == 0 ? 0 : (int)items.indexOf(newitems[i - 1]) + 1;
+		int from = (int)items.indexOf(item);
+		if (from == -1) {
+			beginInsertRows(QModelIndex(), target, target);
+			items.insert(target, item);
+			endInsertRows();
+		} else if (from != target) {
+			beginMoveRows(QModelIndex(), from, from, QModelIndex(), target);
+			MoveItem(items, from, target > from ? target - 1 : target);
+			endMoveRows();
 		}
+	}
 
-		/* get move count */
-		for (count = 1; (idx1New + count) < newitems.count(); count++) {
-			int oldIdx = idx1Old + count;
-			int newIdx = idx1New + count;
-
-			obs_sceneitem_t *oldItem = items[oldIdx];
-			obs_sceneitem_t *newItem = newitems[newIdx];
-
-			if (oldItem != newItem) {
-				break;
-			}
-		}
+	ReconnectSignals();
+	UpdateGroupState(true);
+}
 
-		/* move items */
-		beginMoveRows(QModelIndex(), idx1Old, idx1Old + count - 1, QModelIndex(), idx1New + count);
-		for (i = 0; i < count; i++) {
-			int to = idx1New + count;
-			if (to > idx1Old)
-				to--;
-			MoveItem(items, idx1Old, to);
-		}
-		endMoveRows();
-	}
+void SourceTreeModel::ReorderItems()
+{
+	SceneChanged();
 }
 
 void SourceTreeModel::Add(obs_sceneitem_t *item)
@@ -748,7 +340,7 @@ void SourceTreeModel::Add(obs_sceneitem_t *item)
 		items.insert(0, item);
 		endInsertRows();
 
-		st->UpdateWidget(createIndex(0, 0, nullptr), item);
+		ConnectSignals(item);
 	}
 }
 
@@ -786,9 +378,11 @@ void SourceTreeModel::Remove(obs_sceneitem_t *item)
 		}
 	}
 
+	DisconnectSignals();
 	beginRemoveRows(QModelIndex(), startIdx, endIdx);
 	items.remove(idx, endIdx - startIdx + 1);
 	endRemoveRows();
+	ReconnectSignals();
 
 	if (is_group)
 		UpdateGroupState(true);
@@ -818,15 +412,75 @@ int SourceTreeModel::rowCount(const QModelIndex &parent) const
 
 QVariant SourceTreeModel::data(const QModelIndex &index, int role) const
 {
-	if (role == Qt::AccessibleTextRole) {
+	if (!index.isValid() || index.row() >= items.count())
+		return QVariant();
+
+	if (role == Qt::AccessibleTextRole || role == Qt::DisplayRole || role == Qt::EditRole) {
 		OBSSceneItem item = items[index.row()];
 		obs_source_t *source = obs_sceneitem_get_source(item);
 		return QVariant(QString::fromUtf8(obs_source_get_name(source)));
 	}
 
+	// the visibility and lock toggles are painted by the delegate, describe them on the row instead
+	if (role == Qt::AccessibleDescriptionRole) {
+		OBSSceneItem item = items[index.row()];
+		const QString name = QString::fromUtf8(obs_source_get_name(obs_sceneitem_get_source(item)));
+		auto toggle = [&name](const char *label, const char *description) {
+			return QString::fromUtf8(obs_frontend_get_locale_string(label)) + ": " +
+			       QString::fromUtf8(obs_frontend_get_locale_string(description)).arg(name);
+		};
+		return QVariant(toggle("Basic.Main.Sources.Visibility", "Basic.Main.Sources.VisibilityDescription") + "\n" +
+				toggle("Basic.Main.Sources.Lock", "Basic.Main.Sources.LockDescription"));
+	}
+
 	return QVariant();
 }
 
+bool SourceTreeModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+	if (role != Qt::EditRole || !index.isValid() || index.row() >= items.count())
+		return false;
+
+	std::string newName = value.toString().toUtf8().constData();
+
+	/* ----------------------------------------- */
+	/* check for empty string                    */
+
+	if (newName.empty()) {
+		QMessageBox::information(st, QString::fromUtf8(obs_frontend_get_locale_string("NoNameEntered.Title")),
+					 QString::fromUtf8(obs_frontend_get_locale_string("NoNameEntered.Text")));
+		return false;
+	}
+
+	/* ----------------------------------------- */
+	/* Check for same name                       */
+
+	obs_source_t *source = obs_sceneitem_get_source(items[index.row()]);
+	if (newName == obs_source_get_name(source))
+		return false;
+
+	/* ----------------------------------------- */
+	/* check for existing source                 */
+	obs_canvas_t *canvas = (obs_source_get_output_flags(source) & OBS_SOURCE_REQUIRES_CANVAS) ? obs_source_get_canvas(source)
+												  : nullptr;
+	OBSSourceAutoRelease existingSource = canvas ? obs_canvas_get_source_by_name(canvas, newName.c_str())
+						     : obs_get_source_by_name(newName.c_str());
+	bool exists = !!existingSource;
+
+	if (exists) {
+		QMessageBox::information(st, QString::fromUtf8(obs_frontend_get_locale_string("NameExists.Title")),
+					 QString::fromUtf8(obs_frontend_get_locale_string("NameExists.Text")));
+		return false;
+	}
+
+	/* ----------------------------------------- */
+	/* rename                                    */
+
+	obs_source_set_name(source, newName.c_str());
+	emit dataChanged(index, index);
+	return true;
+}
+
 Qt::ItemFlags SourceTreeModel::flags(const QModelIndex &index) const
 {
 	if (!index.isValid())
@@ -869,7 +523,7 @@ void SourceTreeModel::AddGroup()
 	items.insert(0, group);
 	endInsertRows();
 
-	st->UpdateWidget(createIndex(0, 0, nullptr), group);
+	ConnectSignals(group);
 	UpdateGroupState(true);
 
 	QMetaObject::invokeMethod(st, "Edit", Qt::QueuedConnection, Q_ARG(int, 0));
@@ -899,7 +553,8 @@ void SourceTreeModel::GroupSelectedItems(QModelIndexList &indices)
 		obs_sceneitem_select(si, false);
 
 	hasGroups = true;
-	st->UpdateWidgets(true);
+	ReconnectSignals();
+	st->viewport()->update();
 
 	obs_sceneitem_select(item, true);
 
@@ -946,7 +601,8 @@ void SourceTreeModel::ExpandGroup(obs_sceneitem_t *item)
 		items.insert(i + itemIdx, subItems[i]);
 	endInsertRows();
 
-	st->UpdateWidgets();
+	for (auto &subItem : subItems)
+		ConnectSignals(subItem);
 }
 
 void SourceTreeModel::CollapseGroup(obs_sceneitem_t *item)
@@ -969,9 +625,11 @@ void SourceTreeModel::CollapseGroup(obs_sceneitem_t *item)
 	if (startIdx == -1)
 		return;
 
+	DisconnectSignals();
 	beginRemoveRows(QModelIndex(), startIdx, endIdx);
 	items.remove(startIdx, endIdx - startIdx + 1);
 	endRemoveRows();
+	ReconnectSignals();
 }
 
 void SourceTreeModel::UpdateGroupState(bool update)
@@ -987,7 +645,7 @@ void SourceTreeModel::UpdateGroupState(bool update)
 	if (nowHasGroups != hasGroups) {
 		hasGroups = nowHasGroups;
 		if (update) {
-			st->UpdateWidgets(true);
+			st->viewport()->update();
 		}
 	}
 }
@@ -1001,10 +659,14 @@ SourceTree::SourceTree(std::mutex *select_mutex, std::vector<obs_sceneitem_t *>
 	  hoveredPreviewItems(hovered_preview_items),
 	  getScene(get_scene),
 	  getSceneParam(get_scene_param),
-	  canvasDock(canvas_dock)
+	  canvasDock(canvas_dock),
+	  sceneRefresh(this, [this] { GetStm()->SceneChanged(); })
 {
 	SourceTreeModel *stm_ = new SourceTreeModel(this);
 	setModel(stm_);
+	setUniformItemSizes(true);
+	setMouseTracking(true);
+	setEditTriggers(QAbstractItemView::NoEditTriggers);
 	setStyleSheet(QString("*[bgColor=\"1\"]{background-color:rgba(255,68,68,33%);}"
 			      "*[bgColor=\"2\"]{background-color:rgba(255,255,68,33%);}"
 			      "*[bgColor=\"3\"]{background-color:rgba(68,255,68,33%);}"
@@ -1024,48 +686,50 @@ SourceTree::SourceTree(std::mutex *select_mutex, std::vector<obs_sceneitem_t *>
 
 void SourceTree::UpdateIcons()
 {
-	SourceTreeModel *stm = GetStm();
-	stm->SceneChanged();
+	iconCache.clear();
+	viewport()->update();
 }
 
 void SourceTree::SetIconsVisible(bool visible)
 {
-	SourceTreeModel *stm = GetStm();
-
 	iconsVisible = visible;
-	stm->SceneChanged();
+	viewport()->update();
 }
 
-void SourceTree::ResetWidgets()
+QIcon SourceTree::GetItemIcon(obs_source_t *source)
 {
-	SourceTreeModel *stm = GetStm();
-	stm->UpdateGroupState(false);
-
-	for (int i = 0; i < stm->items.count(); i++) {
-		QModelIndex index = stm->createIndex(i, 0, nullptr);
-		setIndexWidget(index, new SourceTreeItem(this, stm->items[i]));
-	}
-}
+	const char *id = obs_source_get_id(source);
+	if (!id)
+		return QIcon();
+
+	auto it = iconCache.find(id);
+	if (it != iconCache.end())
+		return it->second;
+
+	QIcon icon;
+	if (strcmp(id, "scene") == 0)
+		icon = GetSceneIcon();
+	else if (strcmp(id, "group") == 0)
+		icon = GetGroupIcon();
+	else
+		icon = GetIconFromType(obs_source_get_icon_type(id));
 
-void SourceTree::UpdateWidget(const QModelIndex &idx, obs_sceneitem_t *item)
-{
-	setIndexWidget(idx, new SourceTreeItem(this, item));
+	iconCache.emplace(id, icon);
+	return icon;
 }
 
-void SourceTree::UpdateWidgets(bool force)
+void SourceTree::SetHoveredIndex(const QModelIndex &index)
 {
-	SourceTreeModel *stm = GetStm();
+	if (hoveredIndex == index)
+		return;
 
-	for (int i = 0; i < stm->items.size(); i++) {
-		obs_sceneitem_t *item = stm->items[i];
-		SourceTreeItem *widget = GetItemWidget(i);
+	hoveredIndex = index;
 
-		if (!widget) {
-			UpdateWidget(stm->createIndex(i, 0), item);
-		} else {
-			widget->Update(force);
-		}
-	}
+	SourceTreeModel *stm = GetStm();
+	std::lock_guard<std::mutex> l(*selectMutex);
+	hoveredPreviewItems->clear();
+	if (index.isValid() && index.row() < stm->items.count())
+		hoveredPreviewItems->push_back(stm->items[index.row()]);
 }
 
 void SourceTree::SelectItem(obs_sceneitem_t *sceneitem, bool select)
@@ -1094,9 +758,25 @@ void SourceTree::mouseDoubleClickEvent(QMouseEvent *event)
 		QListView::mouseDoubleClickEvent(event);
 }
 
+void SourceTree::mouseMoveEvent(QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	SetHoveredIndex(indexAt(event->position().toPoint()));
+#else
+	SetHoveredIndex(indexAt(event->pos()));
+#endif
+	QListView::mouseMoveEvent(event);
+}
+
+void SourceTree::leaveEvent(QEvent *event)
+{
+	SetHoveredIndex(QModelIndex());
+	QListView::leaveEvent(event);
+}
+
 void SourceTree::dropEvent(QDropEvent *event)
 {
-	if (event->source() != this) {
+	if (event->source() != this || FlushSceneChanged()) {
 		QListView::dropEvent(event);
 		return;
 	}
@@ -1375,9 +1055,9 @@ void SourceTree::dropEvent(QDropEvent *event)
 	}
 
 	/* --------------------------------------- */
-	/* update widgets and accept event         */
+	/* update signals and accept event         */
 
-	UpdateWidgets(true);
+	stm->ReconnectSignals();
 
 	event->accept();
 	event->setDropAction(Qt::CopyAction);
@@ -1434,23 +1114,15 @@ void SourceTree::NewGroupEdit(int row)
 
 bool SourceTree::Edit(int row)
 {
+	FlushSceneChanged();
 	SourceTreeModel *stm = GetStm();
 	if (row < 0 || row >= stm->items.count())
 		return false;
 
-	QModelIndex index = stm->createIndex(row, 0);
-	QWidget *widget = indexWidget(index);
-	SourceTreeItem *itemWidget = reinterpret_cast<SourceTreeItem *>(widget);
-	if (itemWidget->IsEditing()) {
-#ifdef __APPLE__
-		itemWidget->ExitEditMode(true);
-#endif
+	if (state() == QAbstractItemView::EditingState)
 		return false;
-	}
 
-	itemWidget->EnterEditMode();
-	edit(index);
-	return true;
+	return edit(stm->createIndex(row, 0), QAbstractItemView::AllEditTriggers, nullptr);
 }
 
 bool SourceTree::MultipleBaseSelected() const
@@ -1525,6 +1197,7 @@ void SourceTree::Remove(OBSSceneItem item, OBSScene scene)
 	if (canvasDock && canvasDock != component_dock &&
 	    std::find(canvas_docks.begin(), canvas_docks.end(), canvasDock) == canvas_docks.end())
 		return;
+	FlushSceneChanged();
 	GetStm()->Remove(item);
 	obs_frontend_save();
 
@@ -1536,6 +1209,7 @@ void SourceTree::Remove(OBSSceneItem item, OBSScene scene)
 
 void SourceTree::GroupSelectedItems()
 {
+	FlushSceneChanged();
 	QModelIndexList indices = selectedIndexes();
 	std::sort(indices.begin(), indices.end());
 	GetStm()->GroupSelectedItems(indices);
@@ -1543,12 +1217,14 @@ void SourceTree::GroupSelectedItems()
 
 void SourceTree::UngroupSelectedGroups()
 {
+	FlushSceneChanged();
 	QModelIndexList indices = selectedIndexes();
 	GetStm()->UngroupSelectedGroups(indices);
 }
 
 void SourceTree::AddGroup()
 {
+	FlushSceneChanged();
 	GetStm()->AddGroup();
 }
 
@@ -1603,15 +1279,250 @@ void SourceTree::paintEvent(QPaintEvent *event)
 	}
 }
 
-SourceTreeDelegate::SourceTreeDelegate(QObject *parent) : QStyledItemDelegate(parent) {}
+SourceTreeDelegate::SourceTreeDelegate(SourceTree *parent) : QStyledItemDelegate(parent), tree(parent)
+{
+	expandTemplate = new SourceTreeSubItemCheckBox();
+	expandTemplate->setProperty("class", "checkbox-icon indicator-expand");
+	expandTemplate->setParent(tree);
+	expandTemplate->hide();
+
+	visTemplate = new VisibilityCheckBox();
+	visTemplate->setProperty("class", "checkbox-icon indicator-visibility");
+	visTemplate->setParent(tree);
+	visTemplate->hide();
+
+	lockTemplate = new LockedCheckBox();
+	lockTemplate->setProperty("class", "checkbox-icon indicator-lock");
+	lockTemplate->setParent(tree);
+	lockTemplate->hide();
+
+	// color presets are painted through widgets carrying the bgColor property, so the theme can restyle them
+	for (int i = 0; i < SOURCE_TREE_COLOR_PRESETS; i++) {
+		auto colorTemplate = new QWidget(tree);
+		colorTemplate->setProperty("bgColor", i + 1);
+		colorTemplate->hide();
+		colorTemplates[i] = colorTemplate;
+	}
+}
+
+static QSize IndicatorSize(QCheckBox *tmpl)
+{
+	tmpl->ensurePolished();
+	QStyle *style = tmpl->style();
+	return QSize(style->pixelMetric(QStyle::PM_IndicatorWidth, nullptr, tmpl),
+		     style->pixelMetric(QStyle::PM_IndicatorHeight, nullptr, tmpl));
+}
+
+SourceTreeDelegate::RowLayout SourceTreeDelegate::GetRowLayout(const QStyleOptionViewItem &option,
+							       const QModelIndex &index) const
+{
+	RowLayout layout;
+	SourceTreeModel *stm = tree->GetStm();
+	if (!index.isValid() || index.row() >= stm->items.count())
+		return layout;
+
+	obs_sceneitem_t *item = stm->items[index.row()];
+	const QRect &r = option.rect;
+	const int spacing = 4;
+
+	auto centered = [&r](int x, QSize size) {
+		return QRect(x, r.top() + (r.height() - size.height()) / 2, size.width(), size.height());
+	};
+
+	int right = r.right() + 1;
+#ifdef __APPLE__
+	/* Hack: Fixes a bug where scrollbars would be above the lock icon */
+	right -= 16;
+#endif
+	QSize size = IndicatorSize(lockTemplate);
+	right -= size.width();
+	layout.lock = centered(right, size);
+	size = IndicatorSize(visTemplate);
+	right -= size.width() + spacing;
+	layout.vis = centered(right, size);
+	right -= spacing;
+
+	int x = r.left();
+	if (obs_sceneitem_is_group(item)) {
+		size = IndicatorSize(expandTemplate);
+		layout.expand = centered(x, size);
+		x += size.width() + spacing;
+	} else if (obs_sceneitem_get_scene(item) != tree->getScene(tree->getSceneParam)) {
+		x += 16 + spacing;
+	} else {
+		x += 3 + spacing;
+	}
+
+	if (tree->iconsVisible) {
+		layout.icon = centered(x, QSize(16, 16));
+		x += 16 + 2;
+	}
+
+	layout.label = QRect(x, r.top(), std::max(right - x, 0), r.height());
+	return layout;
+}
+
+void SourceTreeDelegate::DrawIndicator(QPainter *painter, QCheckBox *tmpl, const QRect &rect, bool checked) const
+{
+	QStyleOptionButton opt;
+	opt.initFrom(tmpl);
+	opt.rect = rect;
+	opt.state &= ~(QStyle::State_On | QStyle::State_Off | QStyle::State_MouseOver);
+	opt.state |= QStyle::State_Enabled | (checked ? QStyle::State_On : QStyle::State_Off);
+	tmpl->style()->drawPrimitive(QStyle::PE_IndicatorCheckBox, &opt, painter, tmpl);
+}
 
 QSize SourceTreeDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-	SourceTree *tree = qobject_cast<SourceTree *>(parent());
-	QWidget *item = tree->indexWidget(index);
+	QSize size = QStyledItemDelegate::sizeHint(option, index);
+	size.setHeight(std::max({size.height(), IndicatorSize(visTemplate).height(), IndicatorSize(lockTemplate).height(), 16}));
+	return size;
+}
+
+void SourceTreeDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	SourceTreeModel *stm = tree->GetStm();
+	if (!index.isValid() || index.row() >= stm->items.count())
+		return;
 
-	if (!item)
-		return QStyledItemDelegate::sizeHint(option, index);
+	obs_sceneitem_t *item = stm->items[index.row()];
+	obs_source_t *source = obs_sceneitem_get_source(item);
 
-	return (QSize(item->sizeHint()));
+	QStyleOptionViewItem opt = option;
+	initStyleOption(&opt, index);
+	opt.text.clear();
+	const QWidget *widget = option.widget;
+	QStyle *style = widget ? widget->style() : tree->style();
+	style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+	OBSDataAutoRelease privData = obs_sceneitem_get_private_settings(item);
+	int preset = (int)obs_data_get_int(privData, "color-preset");
+	if (preset == 1) {
+		QColor color(QString::fromUtf8(obs_data_get_string(privData, "color")));
+		if (color.isValid())
+			painter->fillRect(option.rect, color);
+	} else if (preset > 1 && preset - 2 < SOURCE_TREE_COLOR_PRESETS) {
+		QWidget *colorTemplate = colorTemplates[preset - 2];
+		colorTemplate->ensurePolished();
+		QStyleOption colorOpt;
+		colorOpt.initFrom(colorTemplate);
+		colorOpt.rect = option.rect;
+		colorTemplate->style()->drawPrimitive(QStyle::PE_Widget, &colorOpt, painter, colorTemplate);
+	}
+
+	RowLayout layout = GetRowLayout(option, index);
+	const bool visible = obs_sceneitem_visible(item);
+
+	if (!layout.expand.isNull())
+		DrawIndicator(painter, expandTemplate, layout.expand, obs_data_get_bool(privData, "collapsed"));
+
+	if (!layout.icon.isNull()) {
+		QIcon icon = tree->GetItemIcon(source);
+		icon.paint(painter, layout.icon, Qt::AlignCenter, visible ? QIcon::Normal : QIcon::Disabled);
+	}
+
+	painter->save();
+	const QPalette::ColorGroup group = visible ? QPalette::Normal : QPalette::Disabled;
+	const QPalette::ColorRole role = (option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+	painter->setPen(option.palette.color(group, role));
+	painter->setFont(opt.font);
+	QString name = opt.fontMetrics.elidedText(QString::fromUtf8(obs_source_get_name(source)), Qt::ElideRight,
+						  layout.label.width());
+	painter->drawText(layout.label, Qt::AlignLeft | Qt::AlignVCenter, name);
+	painter->restore();
+
+	DrawIndicator(painter, visTemplate, layout.vis, visible);
+	DrawIndicator(painter, lockTemplate, layout.lock, obs_sceneitem_locked(item));
+}
+
+bool SourceTreeDelegate::editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+				     const QModelIndex &index)
+{
+	const QEvent::Type type = event->type();
+	if (type != QEvent::MouseButtonPress && type != QEvent::MouseButtonRelease && type != QEvent::MouseButtonDblClick)
+		return QStyledItemDelegate::editorEvent(event, model, option, index);
+
+	// the row belongs to the previous scene while a refresh is pending
+	if (tree->FlushSceneChanged())
+		return true;
+
+	QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+	SourceTreeModel *stm = tree->GetStm();
+	if (mouseEvent->button() != Qt::LeftButton || !index.isValid() || index.row() >= stm->items.count())
+		return QStyledItemDelegate::editorEvent(event, model, option, index);
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	const QPoint pos = mouseEvent->position().toPoint();
+#else
+	const QPoint pos = mouseEvent->pos();
+#endif
+	RowLayout layout = GetRowLayout(option, index);
+	OBSSceneItem item = stm->items[index.row()];
+	const bool onVis = layout.vis.contains(pos);
+	const bool onLock = layout.lock.contains(pos);
+	const bool onExpand = !layout.expand.isNull() && layout.expand.contains(pos);
+
+	auto toggleCollapsed = [stm, item] {
+		OBSDataAutoRelease private_settings = obs_sceneitem_get_private_settings(item);
+		bool collapsed = !obs_data_get_bool(private_settings, "collapsed");
+		obs_data_set_bool(private_settings, "collapsed", collapsed);
+		if (collapsed)
+			stm->CollapseGroup(item);
+		else
+			stm->ExpandGroup(item);
+	};
+
+	if (type == QEvent::MouseButtonDblClick && !onVis && !onLock) {
+		if (obs_sceneitem_is_group(item)) {
+			toggleCollapsed();
+			return true;
+		}
+		obs_source_t *source = obs_sceneitem_get_source(item);
+		if (source) {
+#if defined(_WIN32)
+			/* This timer works around a bug introduced around Qt 6.8.3 that causes
+			 * the application to hang when double clicking the sources list and the
+			 * Windows setting 'Snap mouse to default button in dialog boxes' is enabled.
+			 */
+			BOOL snapEnabled = FALSE;
+			SystemParametersInfo(SPI_GETSNAPTODEFBUTTON, 0, &snapEnabled, 0);
+
+			if (snapEnabled) {
+				OBSSource ref = source;
+				QTimer::singleShot(200, tree, [ref]() { obs_frontend_open_source_properties(ref); });
+			} else {
+				obs_frontend_open_source_properties(source);
+			}
+#else
+			obs_frontend_open_source_properties(source);
+#endif
+		}
+		return true;
+	}
+
+	if (!onVis && !onLock && !onExpand)
+		return QStyledItemDelegate::editorEvent(event, model, option, index);
+
+	if (type == QEvent::MouseButtonRelease) {
+		if (onVis) {
+			obs_sceneitem_set_visible(item, !obs_sceneitem_visible(item));
+		} else if (onLock) {
+			obs_sceneitem_set_locked(item, !obs_sceneitem_locked(item));
+		} else {
+			toggleCollapsed();
+		}
+		tree->viewport()->update(option.rect);
+	}
+	return true;
+}
+
+QWidget *SourceTreeDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &, const QModelIndex &) const
+{
+	return new QLineEdit(parent);
+}
+
+void SourceTreeDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+					      const QModelIndex &index) const
+{
+	editor->setGeometry(GetRowLayout(option, index).label);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../refresh-coalescer.hpp"
 #include <QList>
 #include <QVector>
 #include <QPointer>
@@ -10,119 +11,58 @@
 #include <QStyledItemDelegate>
 #include <obs.hpp>
 #include <obs-frontend-api.h>
+#include <map>
 #include <mutex>
+#include <set>
+#include <string>
+
+#define SOURCE_TREE_COLOR_PRESETS 8
 
-class QLabel;
 class QCheckBox;
-class QLineEdit;
 class SourceTree;
-class QSpacerItem;
-class QHBoxLayout;
 class LockedCheckBox;
 class VisibilityCheckBox;
-class VisibilityItemWidget;
 class CanvasDock;
 
 class SourceTreeSubItemCheckBox : public QCheckBox {
 	Q_OBJECT
 };
 
-class SourceTreeItem : public QFrame {
-	Q_OBJECT
-
-	friend class SourceTree;
-	friend class SourceTreeModel;
-
-	void mouseDoubleClickEvent(QMouseEvent *event) override;
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-	void enterEvent(QEnterEvent *event) override;
-#else
-	void enterEvent(QEvent *event) override;
-#endif
-	void leaveEvent(QEvent *event) override;
-
-	virtual bool eventFilter(QObject *object, QEvent *event) override;
-
-	void Update(bool force);
-
-	enum class Type {
-		Unknown,
-		Item,
-		Group,
-		SubItem,
-	};
-
-	void DisconnectSignals();
-	void ReconnectSignals();
-
-	Type type = Type::Unknown;
-
-public:
-	explicit SourceTreeItem(SourceTree *tree, OBSSceneItem sceneitem);
-	~SourceTreeItem();
-	bool IsEditing();
-
-private:
-	QSpacerItem *spacer = nullptr;
-	QCheckBox *expand = nullptr;
-	QLabel *iconLabel = nullptr;
-	VisibilityCheckBox *vis = nullptr;
-	LockedCheckBox *lock = nullptr;
-	QHBoxLayout *boxLayout = nullptr;
-	QLabel *label = nullptr;
-
-	QLineEdit *editor = nullptr;
-
-	std::string newName;
-
-	SourceTree *tree;
-	OBSSceneItem sceneitem;
-	std::vector<OBSSignal> sigs;
-	static void removeScene(void *data, calldata_t *cd);
-	static void removeItem(void *data, calldata_t *cd);
-	static void itemVisible(void *data, calldata_t *cd);
-	static void itemLocked(void *data, calldata_t *cd);
-	static void itemSelect(void *data, calldata_t *cd);
-	static void itemDeselect(void *data, calldata_t *cd);
-	static void reorderGroup(void *data, calldata_t *);
-	static void renamed(void *data, calldata_t *cd);
-	static void removeSource(void *data, calldata_t *);
-
-	virtual void paintEvent(QPaintEvent *event) override;
-
-	void ExitEditModeInternal(bool save);
-
-private slots:
-	void Clear();
-
-	void EnterEditMode();
-	void ExitEditMode(bool save);
-
-	void VisibilityChanged(bool visible);
-	void LockedChanged(bool locked);
-	void Renamed(const QString &name);
-
-	void ExpandClicked(bool checked);
-
-	void Select();
-	void Deselect();
-};
-
 class SourceTreeModel : public QAbstractListModel {
 	Q_OBJECT
 
 	friend class SourceTree;
-	friend class SourceTreeItem;
+	friend class SourceTreeDelegate;
 	friend class CanvasDock;
 	friend class SourcesDock;
 
 	SourceTree *st;
 	QVector<OBSSceneItem> items;
+	OBSWeakSource itemsScene;
 	bool hasGroups = false;
+	std::vector<OBSSignal> sigs;
+	std::set<obs_scene_t *> signalScenes;
+	std::set<obs_source_t *> signalSources;
 
 	static void OBSFrontendEvent(enum obs_frontend_event event, void *ptr);
+	static void removeScene(void *data, calldata_t *cd);
+	static void removeItem(void *data, calldata_t *cd);
+	static void itemChanged(void *data, calldata_t *cd);
+	static void itemSelect(void *data, calldata_t *cd);
+	static void itemDeselect(void *data, calldata_t *cd);
+	static void reorderGroup(void *data, calldata_t *);
+	static void sourceChanged(void *data, calldata_t *cd);
+	static void removeSource(void *data, calldata_t *);
+
+	void ConnectSceneSignals(obs_scene_t *scene);
+	void ConnectSignals(obs_sceneitem_t *item);
+	void ReconnectSignals();
+	void DisconnectSignals();
+	void UpdateItem(obs_sceneitem_t *item);
+	void UpdateSource(obs_source_t *source);
 	void Clear();
 	void SceneChanged();
+	void ApplyItems(const QVector<OBSSceneItem> &newitems);
 	void ReorderItems();
 
 	void Add(obs_sceneitem_t *item);
@@ -145,6 +85,7 @@ public:
 
 	virtual int rowCount(const QModelIndex &parent) const override;
 	virtual QVariant data(const QModelIndex &index, int role) const override;
+	virtual bool setData(const QModelIndex &index, const QVariant &value, int role) override;
 
 	virtual Qt::ItemFlags flags(const QModelIndex &index) const override;
 	virtual Qt::DropActions supportedDropActions() const override;
@@ -161,7 +102,7 @@ class SourceTree : public QListView {
 	void *getSceneParam;
 
 	friend class SourceTreeModel;
-	friend class SourceTreeItem;
+	friend class SourceTreeDelegate;
 	friend class CanvasDock;
 	friend class SourcesDock;
 
@@ -170,22 +111,17 @@ class SourceTree : public QListView {
 	//QSvgRenderer iconNoSources;
 
 	bool iconsVisible = true;
+	std::map<std::string, QIcon> iconCache;
+	QPersistentModelIndex hoveredIndex;
+	RefreshCoalescer sceneRefresh;
 
 	void UpdateNoSourcesMessage();
-
-	void ResetWidgets();
-	void UpdateWidget(const QModelIndex &idx, obs_sceneitem_t *item);
-	void UpdateWidgets(bool force = false);
+	void SetHoveredIndex(const QModelIndex &index);
+	QIcon GetItemIcon(obs_source_t *source);
 
 	inline SourceTreeModel *GetStm() const { return reinterpret_cast<SourceTreeModel *>(model()); }
 
 public:
-	inline SourceTreeItem *GetItemWidget(int idx)
-	{
-		QWidget *widget = indexWidget(GetStm()->createIndex(idx, 0));
-		return reinterpret_cast<SourceTreeItem *>(widget);
-	}
-
 	explicit SourceTree(std::mutex *select_mutex, std::vector<obs_sceneitem_t *> *hovered_preview_items,
 			    obs_scene_t *(*get_scene)(void *), void *get_scene_param,
 			    CanvasDock *canvas_dock,
@@ -194,7 +130,11 @@ public:
 	inline bool IgnoreReorder() const { return ignoreReorder; }
 	inline void Clear() { GetStm()->Clear(); }
 
-	inline void Add(obs_sceneitem_t *item) { GetStm()->Add(item); }
+	inline void Add(obs_sceneitem_t *item)
+	{
+		if (!sceneRefresh.IsPending())
+			GetStm()->Add(item);
+	}
 	inline OBSSceneItem Get(int idx) { return GetStm()->Get(idx); }
 	inline QString GetNewGroupName() { return GetStm()->GetNewGroupName(); }
 
@@ -207,9 +147,21 @@ public:
 	void UpdateIcons();
 	void SetIconsVisible(bool visible);
 
+	inline void QueueSceneChanged() { sceneRefresh.Trigger(); }
+	// the model keeps the previous scene while a refresh is pending, run it before acting on rows
+	inline bool FlushSceneChanged() { return sceneRefresh.Flush(); }
+
 public slots:
-	inline void ReorderItems() { GetStm()->ReorderItems(); }
-	inline void RefreshItems() { GetStm()->SceneChanged(); }
+	inline void ReorderItems()
+	{
+		if (!sceneRefresh.IsPending())
+			GetStm()->ReorderItems();
+	}
+	inline void RefreshItems()
+	{
+		sceneRefresh.Cancel();
+		GetStm()->SceneChanged();
+	}
 	void Remove(OBSSceneItem item, OBSScene scene);
 	void GroupSelectedItems();
 	void UngroupSelectedGroups();
@@ -219,6 +171,8 @@ public slots:
 
 protected:
 	virtual void mouseDoubleClickEvent(QMouseEvent *event) override;
+	virtual void mouseMoveEvent(QMouseEvent *event) override;
+	virtual void leaveEvent(QEvent *event) override;
 	virtual void dropEvent(QDropEvent *event) override;
 	virtual void paintEvent(QPaintEvent *event) override;
 
@@ -228,7 +182,30 @@ protected:
 class SourceTreeDelegate : public QStyledItemDelegate {
 	Q_OBJECT
 
+	SourceTree *tree;
+	SourceTreeSubItemCheckBox *expandTemplate;
+	VisibilityCheckBox *visTemplate;
+	LockedCheckBox *lockTemplate;
+	QWidget *colorTemplates[SOURCE_TREE_COLOR_PRESETS];
+
+	struct RowLayout {
+		QRect expand;
+		QRect icon;
+		QRect label;
+		QRect vis;
+		QRect lock;
+	};
+	RowLayout GetRowLayout(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+	void DrawIndicator(QPainter *painter, QCheckBox *tmpl, const QRect &rect, bool checked) const;
+
 public:
-	SourceTreeDelegate(QObject *parent);
+	SourceTreeDelegate(SourceTree *parent);
 	virtual QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+	virtual void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+	virtual bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+				 const QModelIndex &index) override;
+	virtual QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+				      const QModelIndex &index) const override;
+	virtual void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+					  const QModelIndex &index) const override;
 };